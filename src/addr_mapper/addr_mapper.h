@@ -12,12 +12,52 @@ namespace Ramulator {
 class IAddrMapper {
   RAMULATOR_REGISTER_INTERFACE(IAddrMapper, "AddrMapper", "Memory Controller Address Mapper");
 
+  protected:
+    int m_channel_level = -1;
+    int m_rank_level = -1;      // -1 if the DRAM has no rank level
+    int m_num_channels = -1;
+    int m_num_ranks = 1;        // Per channel
+
   public:
     /**
      * @brief  Applies the address mapping to a physical address and returns the DRAM address vector
      * 
      */
     virtual void apply(Request& req) = 0;   
+
+    /**
+     * @brief  The number of channels, and of ranks per channel, that addresses map to (valid once the mapper is set up)
+     * 
+     */
+    int get_num_channels() const { return m_num_channels; };
+    int get_num_ranks() const { return m_num_ranks; };
+
+    /**
+     * @brief  Returns the channel that a physical address maps to, and its rank within the channel in rank (if given)
+     * 
+     */
+    int get_channel(Addr_t addr, int* rank = nullptr) {
+      Request req(addr, Request::Type::Read);
+      apply(req);
+      if (rank) {
+        *rank = m_rank_level < 0 ? 0 : req.addr_vec[m_rank_level];
+      }
+      return req.addr_vec[m_channel_level];
+    };
+
+  protected:
+    /**
+     * @brief  Looks up the channel and rank levels of the DRAM. Called by the implementations in setup().
+     * 
+     */
+    void setup_channels(IDRAM* dram) {
+      m_channel_level = dram->m_levels("channel");
+      m_num_channels = dram->get_level_size("channel");
+      if (dram->m_levels.contains("rank")) {
+        m_rank_level = dram->m_levels("rank");
+        m_num_ranks = dram->get_level_size("rank");
+      }
+    };
 };
 
 }       // namespace Ramulator
@@ -1,4 +1,7 @@
 #include <vector>
+#include <map>
+#include <bit>
+#include <sstream>
 
 #include "base/base.h"
 #include "dram/dram.h"
@@ -22,6 +25,7 @@ class LinearMapperBase : public IAddrMapper {
   protected:
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) {
       m_dram = memory_system->get_ifce<IDRAM>();
+      setup_channels(m_dram);
 
       // Populate m_addr_bits vector with the number of address bits for each level in the hierachy
       const auto& count = m_dram->m_organization.count;
@@ -123,4 +127,156 @@ class MOP4CLXOR final : public LinearMapperBase, public Implementation {
     }
 };
 
+/**
+ * @brief   A mapper driven by a bit layout in the configuration instead of C++ code.
+ * @details
+ * The bits of each level are given either as a layout string listing the levels from MSB to LSB (e.g.,
+ * "row bank bankgroup rank column channel", where "column:3" takes only the next 3 bits of the column),
+ * or as an explicit list of physical address bits per level (LSB first). Optional XOR terms hash extra
+ * address bits into individual level bits, e.g., "channel: [[8, 12, 13, 18]]" XORs bits 8, 12, 13 and 18 into
+ * channel bit 0. At setup, the layout is compiled into contiguous (shift, mask) fields and (mask) parity terms.
+ */
+class BitLayoutMapper final : public LinearMapperBase, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IAddrMapper, BitLayoutMapper, "BitLayoutMapper", "Applies a mapping described by a bit layout with optional XOR hashing.");
+
+  private:
+    struct Field {
+      int level;        // addr_vec[level] |= ((addr >> shift) & mask) << dst
+      int shift;
+      Addr_t mask;
+      int dst;
+    };
+
+    struct XorTerm {
+      int level;        // addr_vec[level] ^= parity(addr & mask) << dst
+      uint64_t mask;
+      int dst;
+    };
+
+    std::optional<std::string> m_layout;
+    std::optional<std::map<std::string, std::vector<int>>> m_bits;
+    std::map<std::string, std::vector<std::vector<int>>> m_xor;
+
+    std::vector<Field> m_fields;
+    std::vector<XorTerm> m_xor_terms;
+
+  public:
+    void init() override {
+      m_layout = param<std::string>("layout").desc("The levels from MSB to LSB, e.g., \"row bank rank column channel\". \"level:n\" takes the next n bits of the level.").optional();
+      m_bits = param<std::map<std::string, std::vector<int>>>("bits").desc("The physical address bits of each level, LSB first.").optional();
+      m_xor = param<std::map<std::string, std::vector<std::vector<int>>>>("xor").desc("The physical address bits XORed into each level bit, LSB first.").default_val({});
+
+      if (m_layout.has_value() == m_bits.has_value()) {
+        throw ConfigurationError("BitLayoutMapper needs exactly one of \"layout\" or \"bits\"!");
+      }
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      LinearMapperBase::setup(frontend, memory_system);
+
+      // The physical address bits of each level, LSB first
+      std::vector<std::vector<int>> level_bits(m_num_levels);
+      if (m_layout.has_value()) {
+        std::vector<std::string> tokens;
+        std::stringstream ss(*m_layout);
+        std::string token;
+        while (ss >> token) {
+          tokens.push_back(token);
+        }
+
+        int addr_bit = m_tx_offset;
+        for (auto it = tokens.rbegin(); it != tokens.rend(); it++) {
+          std::string level_name = *it;
+          int num_bits = -1;
+          if (size_t pos = it->find(':'); pos != std::string::npos) {
+            level_name = it->substr(0, pos);
+            num_bits = std::stoi(it->substr(pos + 1));
+          }
+          int level = get_level(level_name);
+          int remaining_bits = m_addr_bits[level] - level_bits[level].size();
+          if (num_bits < 0) {
+            num_bits = remaining_bits;
+          } else if (num_bits > remaining_bits) {
+            throw ConfigurationError("BitLayoutMapper: \"{}\" takes more bits than level {} has left ({})!", *it, level_name, remaining_bits);
+          }
+          for (int i = 0; i < num_bits; i++) {
+            level_bits[level].push_back(addr_bit++);
+          }
+        }
+      } else {
+        for (const auto& [level_name, bits] : *m_bits) {
+          level_bits[get_level(level_name)] = bits;
+        }
+      }
+
+      // Validate the layout
+      uint64_t used_bits = 0;
+      for (int level = 0; level < m_num_levels; level++) {
+        if ((int) level_bits[level].size() != m_addr_bits[level]) {
+          throw ConfigurationError("BitLayoutMapper: Level {} has {} bits in the layout but needs {}!", m_dram->m_levels(level), level_bits[level].size(), m_addr_bits[level]);
+        }
+        for (int bit : level_bits[level]) {
+          if (bit < 0 || bit >= 64 || (used_bits & (uint64_t(1) << bit))) {
+            throw ConfigurationError("BitLayoutMapper: Address bit {} is out of range or used more than once!", bit);
+          }
+          used_bits |= uint64_t(1) << bit;
+        }
+      }
+
+      // Compile runs of consecutive address bits into fields
+      m_fields.clear();
+      for (int level = 0; level < m_num_levels; level++) {
+        const auto& bits = level_bits[level];
+        for (size_t start = 0; start < bits.size();) {
+          size_t end = start + 1;
+          while (end < bits.size() && bits[end] == bits[end - 1] + 1) {
+            end++;
+          }
+          m_fields.push_back({level, bits[start], (Addr_t(1) << (end - start)) - 1, (int) start});
+          start = end;
+        }
+      }
+
+      m_xor_terms.clear();
+      for (const auto& [level_name, terms] : m_xor) {
+        int level = get_level(level_name);
+        if ((int) terms.size() > m_addr_bits[level]) {
+          throw ConfigurationError("BitLayoutMapper: Level {} has {} XOR terms but only {} bits!", level_name, terms.size(), m_addr_bits[level]);
+        }
+        for (size_t dst = 0; dst < terms.size(); dst++) {
+          uint64_t mask = 0;
+          for (int bit : terms[dst]) {
+            if (bit < 0 || bit >= 64) {
+              throw ConfigurationError("BitLayoutMapper: XOR bit {} is out of range!", bit);
+            }
+            mask |= uint64_t(1) << bit;
+          }
+          if (mask != 0) {
+            m_xor_terms.push_back({level, mask, (int) dst});
+          }
+        }
+      }
+    }
+
+    void apply(Request& req) override {
+      req.addr_vec.resize(m_num_levels);
+      std::fill(req.addr_vec.begin(), req.addr_vec.end(), 0);
+      for (const auto& field : m_fields) {
+        req.addr_vec[field.level] |= ((req.addr >> field.shift) & field.mask) << field.dst;
+      }
+      for (const auto& term : m_xor_terms) {
+        req.addr_vec[term.level] ^= (std::popcount(uint64_t(req.addr) & term.mask) & 1) << term.dst;
+      }
+    }
+
+  private:
+    int get_level(const std::string& level_name) {
+      try {
+        return m_dram->m_levels(level_name);
+      } catch (const std::out_of_range& r) {
+        throw ConfigurationError("BitLayoutMapper: Level \"{}\" not found in the spec!", level_name);
+      }
+    }
+};
+
 }   // namespace Ramulator
\ No newline at end of file
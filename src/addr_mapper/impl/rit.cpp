@@ -4,6 +4,7 @@ namespace Ramulator {
 
 void LinearMapperBase_with_rit::setup(IFrontEnd* frontend, IMemorySystem* memory_system) {
   m_dram = memory_system->get_ifce<IDRAM>();
+  setup_channels(m_dram);
 
   // Populate m_addr_bits vector with the number of address bits for each level in the hierachy
   const auto& count = m_dram->m_organization.count;
@@ -32,34 +33,54 @@ void LinearMapperBase_with_rit::setup(IFrontEnd* frontend, IMemorySystem* memory
 
 // initialize RIT
 void LinearMapperBase_with_rit::init_rit(int num_banks, int num_rit_entries){
+  if (m_num_rit_entries != -1) {
+    // The controllers of all channels share the address mapper, so the RIT is only initialized once
+    if (num_banks != m_num_rit_banks || num_rit_entries != m_num_rit_entries) {
+      throw ConfigurationError("The RIT is already initialized with {} banks and {} entries per bank!", m_num_rit_banks, m_num_rit_entries);
+    }
+    return;
+  }
+
   m_num_rit_entries = num_rit_entries;
   m_rank_level = m_dram->m_levels("rank");
   m_bank_level = m_dram->m_levels("bank");
   m_row_level = m_dram->m_levels("row");
 
   // setup RIT
-  for (int i = 0; i < num_banks; i++) {
-    std::unordered_map<int, RIT_entry> rit_bank;
-    m_row_indirection_table.push_back(rit_bank);
+  m_num_rit_banks = num_banks;
+  m_num_rows = m_dram->m_organization.count[m_row_level];
+  // Inserting a pair may temporarily exceed the capacity by 2 (see rit_insert_entry)
+  m_rit_capacity = num_rit_entries + 2;
+  m_rit_sizes.assign(num_banks, 0);
+  m_rit_entries.assign((size_t) num_banks * m_rit_capacity, RIT_entry{-1, -1, false});
+  m_rit_index.assign((size_t) num_banks * m_num_rows, -1);
+
+  // At least 8 filter counters per entry keep the false positive rate of the two hashes low
+  m_filter_bits = 6;
+  while ((1 << m_filter_bits) < 8 * m_rit_capacity) {
+    m_filter_bits++;
   }
+  m_rit_filter.assign((size_t) num_banks << m_filter_bits, 0);
 }
 
 // check if the entry is in the RIT
 int LinearMapperBase_with_rit::check_rit(int flat_bank_id, int src_row){
-  if (m_row_indirection_table[flat_bank_id].find(src_row) != m_row_indirection_table[flat_bank_id].end()) {
-    return m_row_indirection_table[flat_bank_id][src_row].dst_row;
+  int entry = find_rit_entry(flat_bank_id, src_row);
+  if (entry != -1) {
+    return m_rit_entries[(size_t) flat_bank_id * m_rit_capacity + entry].dst_row;
   }
   return -1;
 }
 
 // check if the RIT is full
 bool LinearMapperBase_with_rit::is_rit_full(int flat_bank_id){
-  return m_row_indirection_table[flat_bank_id].size() >= m_num_rit_entries;
+  return m_rit_sizes[flat_bank_id] >= m_num_rit_entries;
 }
 
 // check if the entry is locked
 bool LinearMapperBase_with_rit::is_rit_locked(int flat_bank_id, int src_row){
-  return m_row_indirection_table[flat_bank_id][src_row].lock;
+  int entry = find_rit_entry(flat_bank_id, src_row);
+  return entry != -1 && m_rit_entries[(size_t) flat_bank_id * m_rit_capacity + entry].lock;
 }
 
 // performs the indirection if the row is in the RIT
@@ -88,9 +109,10 @@ void LinearMapperBase_with_rit::apply_indirection(Request& req){
 
 // unlocks all the entries in the RIT at the end of each Epoch
 void LinearMapperBase_with_rit::rit_unlock() {
-  for (auto& bank : m_row_indirection_table) {
-    for (auto& entry : bank) {
-      entry.second.lock = false;
+  for (int bank = 0; bank < m_num_rit_banks; bank++) {
+    RIT_entry* entries = &m_rit_entries[(size_t) bank * m_rit_capacity];
+    for (int i = 0; i < m_rit_sizes[bank]; i++) {
+      entries[i].lock = false;
     }
   }
 }
@@ -98,17 +120,11 @@ void LinearMapperBase_with_rit::rit_unlock() {
 // inserts the entry and its pair into the RIT
 void LinearMapperBase_with_rit::rit_insert_entry(int flat_bank_id, int src_row, int dst_row) {
   // insert the entry into the RIT
-  RIT_entry entry0;
-  entry0.dst_row = dst_row;
-  entry0.lock = true;
-  m_row_indirection_table[flat_bank_id][src_row] = entry0;
+  set_rit_entry(flat_bank_id, src_row, dst_row, true);
   // insert the pair of entry into the RIT
-  RIT_entry entry1;
-  entry1.dst_row = src_row;
-  entry1.lock = true;
-  m_row_indirection_table[flat_bank_id][dst_row] = entry1;
+  set_rit_entry(flat_bank_id, dst_row, src_row, true);
 
-  if(m_row_indirection_table[flat_bank_id].size() > m_num_rit_entries){
+  if(m_rit_sizes[flat_bank_id] > m_num_rit_entries){
     std::cerr << "RIT is full!!!!!!!!!! Check before insertion." << std::endl;
     exit(1);
   }
@@ -117,18 +133,20 @@ void LinearMapperBase_with_rit::rit_insert_entry(int flat_bank_id, int src_row,
 // removes the entry and its pair from the RIT
 void LinearMapperBase_with_rit::rit_remove_entry(int flat_bank_id, int src_row, int dst_row) {
   // remove the entry from the RIT
-  m_row_indirection_table[flat_bank_id].erase(src_row);
+  erase_rit_entry(flat_bank_id, src_row);
   // remove the pair of entry from the RIT
-  m_row_indirection_table[flat_bank_id].erase(dst_row);
+  erase_rit_entry(flat_bank_id, dst_row);
 }
 
 // gets a pair of entries from the RIT to unswap, the pair cannot be in the exclusion_list
-std::pair<int, int> LinearMapperBase_with_rit::get_unswap_pair(int flat_bank_id, const std::unordered_map<int, int>& exclusion_list){
+std::pair<int, int> LinearMapperBase_with_rit::get_unswap_pair(int flat_bank_id, const std::function<bool(int)>& is_excluded){
   std::pair<int, int> unswap_pair;
-  for (auto& entry : m_row_indirection_table[flat_bank_id]) {
-    if (!entry.second.lock && exclusion_list.find(entry.first) == exclusion_list.end() && exclusion_list.find(entry.second.dst_row) == exclusion_list.end()) {
-      unswap_pair.first = entry.first;
-      unswap_pair.second = entry.second.dst_row;
+  const RIT_entry* entries = &m_rit_entries[(size_t) flat_bank_id * m_rit_capacity];
+  for (int i = 0; i < m_rit_sizes[flat_bank_id]; i++) {
+    const RIT_entry& entry = entries[i];
+    if (!entry.lock && !is_excluded(entry.src_row) && !is_excluded(entry.dst_row)) {
+      unswap_pair.first = entry.src_row;
+      unswap_pair.second = entry.dst_row;
       return unswap_pair;
     }
   }
@@ -139,14 +157,62 @@ std::pair<int, int> LinearMapperBase_with_rit::get_unswap_pair(int flat_bank_id,
 // dumps RIT for debug
 void LinearMapperBase_with_rit::dump_rit(int flat_bank_id) {
   std::cout << "======================" << std::endl
-            << "RIT[" << flat_bank_id << "].size(): " << m_row_indirection_table[flat_bank_id].size() << std::endl;
+            << "RIT[" << flat_bank_id << "].size(): " << m_rit_sizes[flat_bank_id] << std::endl;
 
-  for (auto entry: m_row_indirection_table[flat_bank_id]){
-    std::cout << entry.first << " -> " << entry.second.dst_row << "\t" << (entry.second.lock ? "locked": "unlocked") << std::endl;
+  const RIT_entry* entries = &m_rit_entries[(size_t) flat_bank_id * m_rit_capacity];
+  for (int i = 0; i < m_rit_sizes[flat_bank_id]; i++) {
+    std::cout << entries[i].src_row << " -> " << entries[i].dst_row << "\t" << (entries[i].lock ? "locked": "unlocked") << std::endl;
   }
   std::cout << "======================" << std::endl;
 }
 
+// returns the index of the entry of src_row in the RIT of the bank, or -1
+int LinearMapperBase_with_rit::find_rit_entry(int flat_bank_id, int src_row) const {
+  if (m_rit_sizes[flat_bank_id] == 0) {
+    return -1;
+  }
+  // bloom pre-check: an unswapped row is (most likely) filtered out without touching the index
+  const uint16_t* filter = &m_rit_filter[(size_t) flat_bank_id << m_filter_bits];
+  if (filter[rit_filter_slot(src_row, 0x9e3779b1u)] == 0 || filter[rit_filter_slot(src_row, 0x85ebca77u)] == 0) {
+    return -1;
+  }
+  return m_rit_index[(size_t) flat_bank_id * m_num_rows + src_row];
+}
+
+void LinearMapperBase_with_rit::set_rit_entry(int flat_bank_id, int src_row, int dst_row, bool lock) {
+  RIT_entry* entries = &m_rit_entries[(size_t) flat_bank_id * m_rit_capacity];
+  int& index = m_rit_index[(size_t) flat_bank_id * m_num_rows + src_row];
+  if (index == -1) {
+    index = m_rit_sizes[flat_bank_id]++;
+    update_rit_filter(flat_bank_id, src_row, 1);
+  }
+  entries[index] = {src_row, dst_row, lock};
+}
+
+void LinearMapperBase_with_rit::erase_rit_entry(int flat_bank_id, int src_row) {
+  RIT_entry* entries = &m_rit_entries[(size_t) flat_bank_id * m_rit_capacity];
+  int& index = m_rit_index[(size_t) flat_bank_id * m_num_rows + src_row];
+  if (index == -1) {
+    return;
+  }
+  update_rit_filter(flat_bank_id, src_row, -1);
+
+  // Keep the entries dense by moving the last entry into the hole
+  int hole = index;
+  int last = --m_rit_sizes[flat_bank_id];
+  index = -1;
+  if (hole != last) {
+    entries[hole] = entries[last];
+    m_rit_index[(size_t) flat_bank_id * m_num_rows + entries[hole].src_row] = hole;
+  }
+}
+
+void LinearMapperBase_with_rit::update_rit_filter(int flat_bank_id, int src_row, int delta) {
+  uint16_t* filter = &m_rit_filter[(size_t) flat_bank_id << m_filter_bits];
+  filter[rit_filter_slot(src_row, 0x9e3779b1u)] += delta;
+  filter[rit_filter_slot(src_row, 0x85ebca77u)] += delta;
+}
+
 class ChRaBaRoCo_with_rit final : public LinearMapperBase_with_rit, public Implementation {
   RAMULATOR_REGISTER_IMPLEMENTATION(IAddrMapper, ChRaBaRoCo_with_rit, "ChRaBaRoCo_with_rit", "Applies a trival mapping to the address.");
 
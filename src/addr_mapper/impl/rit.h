@@ -1,5 +1,6 @@
 #include <vector>
-#include <unordered_map>
+#include <cstdint>
+#include <functional>
 
 #include "base/base.h"
 #include "dram/dram.h"
@@ -19,17 +20,26 @@ class LinearMapperBase_with_rit : public IAddrMapper {
     int m_col_bits_idx = -1;
     int m_row_bits_idx = -1;
 
-    int m_rank_level = -1;
     int m_bank_level = -1;
     int m_row_level = -1;
-    int m_num_rit_entries = -1;
+    int m_num_rit_entries = -1;     // Capacity of the RIT of each bank, counting both rows of a swap
 
+    // Per-bank RITs. The entries of a bank are kept dense (so that they can be walked in insertion order), and a
+    // direct-mapped index from the rows to their entries is guarded by a counting bloom filter, so that the
+    // lookups of unswapped rows (i.e., most requests) only touch the small filter.
     struct RIT_entry {
-      // src_row is the key of the unordered_map
+      int src_row;
       int dst_row;
       bool lock;
     };
-    std::vector<std::unordered_map<int, RIT_entry>> m_row_indirection_table;
+    int m_num_rit_banks = 0;
+    int m_num_rows = 0;
+    int m_rit_capacity = 0;
+    std::vector<int> m_rit_sizes;             // [flat bank id]
+    std::vector<RIT_entry> m_rit_entries;     // [flat bank id][entry], the first m_rit_sizes[bank] entries are valid
+    std::vector<int> m_rit_index;             // [flat bank id][row], the entry of the row, or -1 if it is not swapped
+    int m_filter_bits = 0;
+    std::vector<uint16_t> m_rit_filter;       // [flat bank id][counter]
 
   public:
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system);
@@ -41,8 +51,17 @@ class LinearMapperBase_with_rit : public IAddrMapper {
     void rit_unlock();
     void rit_insert_entry(int flat_bank_id, int src_row, int dst_row);
     void rit_remove_entry(int flat_bank_id, int src_row, int dst_row);
-    std::pair<int, int> get_unswap_pair(int flat_bank_id, const std::unordered_map<int, int>& exclusion_list);
+    std::pair<int, int> get_unswap_pair(int flat_bank_id, const std::function<bool(int)>& is_excluded);
     void dump_rit(int flat_bank_id);
+
+  private:
+    int find_rit_entry(int flat_bank_id, int src_row) const;
+    void set_rit_entry(int flat_bank_id, int src_row, int dst_row, bool lock);
+    void erase_rit_entry(int flat_bank_id, int src_row);
+    void update_rit_filter(int flat_bank_id, int src_row, int delta);
+    int rit_filter_slot(int src_row, uint32_t multiplier) const {
+      return (uint32_t(src_row) * multiplier) >> (32 - m_filter_bits);
+    };
 };
 
 }   // namespace Ramulator
\ No newline at end of file
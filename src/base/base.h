@@ -21,6 +21,7 @@
 #include "base/request.h"
 #include "base/utils.h"
 #include "base/stats.h"
+#include "base/random.h"
 
 
 #ifndef uint
@@ -158,6 +159,45 @@ class Implementation {
     template <typename T>
     StatWrapper<T>& register_stat(std::vector<T>& val) { StatWrapper<T>* s = new StatWrapper<T>(val, *this, m_stats); return *s; };
     bool has_stats() { return !m_stats.is_empty(); };
+    const Stats& get_stats() const { return m_stats; };
+    const std::vector<Implementation*>& get_children() const { return m_children; };
+
+    /**
+     * @brief    Creates a random number stream of this component, derived from the global seed and its path.
+     * 
+     * @details
+     * Call it in setup() (or later), not in init(): the ids of the parents (e.g., the channel of a controller) are only
+     * set after their children are initialized.
+     * Components that need more than one stream tell them apart with stream_name.
+     * seed_offset (e.g., a per-component "seed" parameter) selects another stream at the same path, so that a
+     * component can be re-randomized without changing the global seed.
+     */
+    RandomStream create_rng_stream(std::string stream_name = "", uint64_t seed_offset = 0) {
+      std::string path = get_component_path();
+      if (stream_name != "") {
+        path.append("/").append(stream_name);
+      }
+      return RandomService::create_stream(path, seed_offset);
+    };
+
+    /**
+     * @brief    Path of this component in the component tree, e.g., "MemorySystem.GenericDRAM/Controller.Generic[Channel 0]".
+     */
+    std::string get_component_path() const {
+      std::string path;
+      if (m_parent) {
+        path = m_parent->get_component_path();
+        path.append("/");
+      }
+      std::string ifce_name = get_ifce_name();
+      std::string name = get_name();
+      path.reserve(path.size() + ifce_name.size() + name.size() + m_id.size() + 3);
+      path.append(ifce_name).append(".").append(name);
+      if (m_id != "_default_id") {
+        path.append("[").append(m_id).append("]");
+      }
+      return path;
+    };
     /**
      * @brief    Recursively print the stats of myself and all my childs
      * 
@@ -191,6 +231,17 @@ class Implementation {
       emitter << YAML::Newline;
     };
 
+    /**
+     * @brief    Recursively write the stats of myself and all my childs to sink, keyed by the component paths
+     * 
+     */
+    void write_stats(StatsSink& sink) {
+      m_stats.write_to(sink, get_component_path());
+      for (auto child_impl : m_children) {
+        child_impl->write_stats(sink);
+      }
+    };
+
     std::string get_id() const { return m_id; };
     void set_id(std::string id) { m_id = id; };
 
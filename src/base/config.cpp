@@ -1,3 +1,5 @@
+#include <fstream>
+
 #include "base/config.h"
 
 
@@ -11,50 +13,59 @@ YAML::Node Config::parse_config_file(const std::string& path_str, const std::vec
     spdlog::error("Config file {} does not exist!", path_str);
     std::exit(-1);
   }
-  
-  const fs::path curr_path(fs::current_path());
+
   YAML::Node node = YAML::LoadFile(path);
-  Details::resolve_included_configs(node);
+  // Includes in the top-level file are relative to the working directory
+  Details::resolve_included_configs(node, fs::path());
   Details::override_configs(node, params);
-  fs::current_path(curr_path);
   return node;
 }
 
-YAML::Node Config::Details::load_config_file(const std::string& path_str) {
-  fs::path path(path_str);
+void Config::dump_resolved_config(const YAML::Node& config, const std::string& path_str) {
+  YAML::Emitter emitter;
+  emitter << YAML::Comment("Resolved Ramulator 2.0 configuration (load with -f/--config_file)");
+  emitter << YAML::Newline << config;
+
+  std::ofstream file(path_str);
+  file << emitter.c_str() << std::endl;
+  if (!file) {
+    spdlog::error("Cannot write the resolved config to {}!", path_str);
+    std::exit(-1);
+  }
+}
+
+YAML::Node Config::Details::load_config_file(const fs::path& path) {
   if (!fs::exists(path)) {
-    spdlog::error("Config file {} does not exist!", path_str);
+    spdlog::error("Config file {} does not exist!", path.string());
     std::exit(-1);
   }
 
-  YAML::Node node = YAML::LoadFile(path);
-  fs::current_path(path.parent_path());
-  return node;
+  return YAML::LoadFile(path);
 }
 
 
-void Config::Details::resolve_included_configs(YAML::Node node) {
+void Config::Details::resolve_included_configs(YAML::Node node, const fs::path& base_path) {
   switch (node.Type()) {
     case YAML::NodeType::Scalar: {
       if (node.Tag() == "!include") {
-        const fs::path curr_path = fs::current_path();
-        node = load_config_file(node.as<std::string>());
-        resolve_included_configs(node);
-        fs::current_path(curr_path);
+        const fs::path include_path = base_path / node.as<std::string>();
+        node = load_config_file(include_path);
+        // Includes in an included file are relative to that file
+        resolve_included_configs(node, include_path.parent_path());
       }
       break;
     }
 
     case YAML::NodeType::Sequence: {
       for (YAML::const_iterator it = node.begin(); it != node.end(); ++it) {
-        resolve_included_configs(*it);
+        resolve_included_configs(*it, base_path);
       }
       break;
     }
     
     case YAML::NodeType::Map: {
       for (YAML::const_iterator it = node.begin(); it != node.end(); ++it) {
-        resolve_included_configs(it->second);
+        resolve_included_configs(it->second, base_path);
       }
       break;
     }
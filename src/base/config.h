@@ -22,24 +22,34 @@ namespace Config {
  */
 YAML::Node parse_config_file(const std::string& path, const std::vector<std::string>& params);
 
+/**
+ * @brief    Write a parsed configuration (with its includes resolved and overrides applied) to a yaml file.
+ *
+ * @param    config         Parsed YAML configurations.
+ * @param    path           Path to the output yaml file.
+ */
+void dump_resolved_config(const YAML::Node& config, const std::string& path);
+
 
 namespace Details {
 
 /**
- * @brief    Load the YAML file and set the current path to the parent path of the file.
+ * @brief    Load the YAML file.
  * 
- * @param    path_str       Path to the yaml file.
+ * @param    path           Path to the yaml file.
  * @return   YAML::Node 
  */
-YAML::Node load_config_file(const std::string& path_str);
+YAML::Node load_config_file(const std::filesystem::path& path);
 
 /**
  * @brief    Traverse the YAML document to load any included YAML files.
+ * @details
+ * Does not change the working directory, so it is safe to call from multi-threaded embedders.
  *
  * @param    node           The current root node.
- * @param    verbose        Whether to print every node during the traversal.
+ * @param    base_path      The directory that relative include paths in this document are relative to.
  */
-void resolve_included_configs(YAML::Node node);
+void resolve_included_configs(YAML::Node node, const std::filesystem::path& base_path);
 
 /**
  * @brief    Override the config (add if non-existent) in the YAML file with the command line options.
@@ -137,6 +137,7 @@ void Factory::dump() {
 }
 
 IFrontEnd* Factory::create_frontend(const YAML::Node& config) {
+  RandomService::set_global_seed(config["seed"].as<uint64_t>(123));
   Implementation* impl = Factory::create_implementation(IFrontEnd::get_name(), config, nullptr);
   IFrontEnd* frontend = dynamic_cast<IFrontEnd*>(impl);
   if (frontend == nullptr) {
@@ -150,6 +151,7 @@ IFrontEnd* Factory::create_frontend(const YAML::Node& config) {
 };
 
 IMemorySystem* Factory::create_memory_system(const YAML::Node& config) {
+  RandomService::set_global_seed(config["seed"].as<uint64_t>(123));
   Implementation* impl = Factory::create_implementation(IMemorySystem::get_name(), config, nullptr);
   IMemorySystem* memory_system = dynamic_cast<IMemorySystem*>(impl);
   if (memory_system == nullptr) {
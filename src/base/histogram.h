@@ -0,0 +1,125 @@
+#ifndef     RAMULATOR_BASE_HISTOGRAM_H
+#define     RAMULATOR_BASE_HISTOGRAM_H
+
+#include <bit>
+#include <cmath>
+#include <array>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+
+#include <yaml-cpp/yaml.h>
+
+namespace Ramulator {
+
+/**
+ * @brief    A log-linear (HDR-style) histogram of non-negative integer values, e.g., latencies in cycles.
+ *
+ * @details
+ * Values below 2^SUB_BUCKET_BITS have a bucket each. Above, every power-of-two range is split into
+ * 2^SUB_BUCKET_BITS equal buckets, so a bucket is at most 1/2^SUB_BUCKET_BITS (~3%) of its values wide.
+ * The buckets cover the whole 64-bit range in a fixed array: record() is O(1) and never allocates.
+ * Percentiles are reported as the highest value of their bucket (but at most the exact maximum).
+ *
+ */
+class Histogram {
+  public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr int NUM_SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * NUM_SUB_BUCKETS;
+
+  private:
+    std::array<uint64_t, NUM_BUCKETS> m_counts {};
+    uint64_t m_count = 0;
+    uint64_t m_sum = 0;
+    uint64_t m_min = std::numeric_limits<uint64_t>::max();
+    uint64_t m_max = 0;
+
+  public:
+    void record(uint64_t value) {
+      m_counts[get_bucket(value)]++;
+      m_count++;
+      m_sum += value;
+      m_min = std::min(m_min, value);
+      m_max = std::max(m_max, value);
+    };
+
+    uint64_t get_count() const { return m_count; };
+    uint64_t get_min() const { return m_count ? m_min : 0; };
+    uint64_t get_max() const { return m_max; };
+    double get_mean() const { return m_count ? (double) m_sum / (double) m_count : 0.0; };
+
+    /**
+     * @brief    Returns the value below or at which percentile % of the recorded values are.
+     */
+    uint64_t get_percentile(double percentile) const {
+      if (m_count == 0) {
+        return 0;
+      }
+      uint64_t target = std::max<uint64_t>(1, (uint64_t) std::ceil(percentile / 100.0 * m_count));
+      uint64_t seen = 0;
+      for (int bucket = 0; bucket < NUM_BUCKETS; bucket++) {
+        seen += m_counts[bucket];
+        if (seen >= target) {
+          return std::min(get_highest_value(bucket), m_max);
+        }
+      }
+      return m_max;
+    };
+
+    /**
+     * @brief    Returns the percentile of the values recorded since earlier (a previous copy of this histogram).
+     */
+    uint64_t get_percentile_since(const Histogram& earlier, double percentile) const {
+      uint64_t count = m_count - earlier.m_count;
+      if (count == 0) {
+        return 0;
+      }
+      uint64_t target = std::max<uint64_t>(1, (uint64_t) std::ceil(percentile / 100.0 * count));
+      uint64_t seen = 0;
+      for (int bucket = 0; bucket < NUM_BUCKETS; bucket++) {
+        seen += m_counts[bucket] - earlier.m_counts[bucket];
+        if (seen >= target) {
+          return std::min(get_highest_value(bucket), m_max);
+        }
+      }
+      return m_max;
+    };
+
+  private:
+    static int get_bucket(uint64_t value) {
+      if (value < NUM_SUB_BUCKETS) {
+        return value;
+      }
+      int msb = std::bit_width(value) - 1;
+      int shift = msb - SUB_BUCKET_BITS;
+      return (shift + 1) * NUM_SUB_BUCKETS + ((value >> shift) & (NUM_SUB_BUCKETS - 1));
+    };
+
+    static uint64_t get_highest_value(int bucket) {
+      if (bucket < NUM_SUB_BUCKETS) {
+        return bucket;
+      }
+      int shift = bucket / NUM_SUB_BUCKETS - 1;
+      uint64_t lowest = (uint64_t) (NUM_SUB_BUCKETS + bucket % NUM_SUB_BUCKETS) << shift;
+      return lowest + ((uint64_t(1) << shift) - 1);
+    };
+};
+
+inline YAML::Emitter& operator << (YAML::Emitter& emitter, const Histogram& h) {
+  emitter << YAML::Flow << YAML::BeginMap;
+  emitter << YAML::Key << "count" << YAML::Value << h.get_count();
+  emitter << YAML::Key << "mean"  << YAML::Value << h.get_mean();
+  emitter << YAML::Key << "p50"   << YAML::Value << h.get_percentile(50.0);
+  emitter << YAML::Key << "p90"   << YAML::Value << h.get_percentile(90.0);
+  emitter << YAML::Key << "p99"   << YAML::Value << h.get_percentile(99.0);
+  emitter << YAML::Key << "p99.9" << YAML::Value << h.get_percentile(99.9);
+  emitter << YAML::Key << "max"   << YAML::Value << h.get_max();
+  emitter << YAML::EndMap;
+  return emitter;
+}
+
+}        // namespace Ramulator
+
+
+#endif   // RAMULATOR_BASE_HISTOGRAM_H
@@ -0,0 +1,49 @@
+#include "base/random.h"
+
+namespace Ramulator {
+
+namespace {
+
+uint64_t splitmix64(uint64_t& x) {
+  uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+}
+
+void RandomStream::set_seed(uint64_t seed) {
+  m_seed = seed;
+  // Expand the seed with splitmix64, which never yields the all-zero state
+  uint64_t x = seed;
+  for (int i = 0; i < 4; i++) {
+    m_state[i] = splitmix64(x);
+  }
+}
+
+void RandomStream::fill_bernoulli(bool* draws, size_t n, double p) {
+  const uint64_t threshold = bernoulli_threshold(p);
+  if (p >= 1.0) {
+    for (size_t i = 0; i < n; i++) {
+      draws[i] = true;
+    }
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    draws[i] = (*this)() < threshold;
+  }
+}
+
+uint64_t RandomService::get_stream_seed(const std::string& path, uint64_t seed_offset) {
+  // FNV-1a hash of the path, mixed with the global seed and the offset (an offset of 0 leaves the seed unchanged)
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (char c : path) {
+    hash ^= (unsigned char) c;
+    hash *= 0x100000001b3ull;
+  }
+  uint64_t x = (m_global_seed ^ hash) + seed_offset * 0x9e3779b97f4a7c15ull;
+  return splitmix64(x);
+}
+
+}        // namespace Ramulator
@@ -0,0 +1,132 @@
+#ifndef     RAMULATOR_BASE_RANDOM_H
+#define     RAMULATOR_BASE_RANDOM_H
+
+#include <string>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+namespace Ramulator {
+
+/**
+ * @brief    A fast, reproducible stream of pseudo-random numbers (xoshiro256**).
+ * 
+ * @details
+ * Satisfies UniformRandomBitGenerator, so it can also drive the std:: distributions.
+ * Get one from Implementation::create_rng_stream() instead of seeding it directly, so that
+ * all streams of a simulation are derived from the global seed.
+ * 
+ */
+class RandomStream {
+  public:
+    using result_type = uint64_t;
+    static constexpr result_type min() { return 0; };
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); };
+
+  private:
+    uint64_t m_seed = 0;
+    uint64_t m_state[4];
+
+  public:
+    explicit RandomStream(uint64_t seed = 0) { set_seed(seed); };
+
+    void set_seed(uint64_t seed);
+    uint64_t get_seed() const { return m_seed; };
+
+    result_type operator()() {
+      const uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+      const uint64_t t = m_state[1] << 17;
+      m_state[2] ^= m_state[0];
+      m_state[3] ^= m_state[1];
+      m_state[1] ^= m_state[2];
+      m_state[0] ^= m_state[3];
+      m_state[2] ^= t;
+      m_state[3] = rotl(m_state[3], 45);
+      return result;
+    };
+
+    /**
+     * @brief    Returns a uniformly distributed integer in [lo, hi] (both inclusive, like std::uniform_int_distribution).
+     */
+    int64_t uniform_int(int64_t lo, int64_t hi) {
+      uint64_t range = uint64_t(hi) - uint64_t(lo) + 1;
+      if (range == 0) {
+        return (int64_t) (*this)();
+      }
+      return lo + (int64_t) bounded(range);
+    };
+
+    /**
+     * @brief    Returns a uniformly distributed double in [0, 1).
+     */
+    double uniform_real() {
+      return ((*this)() >> 11) * 0x1.0p-53;
+    };
+
+    /**
+     * @brief    Returns true with probability p.
+     */
+    bool bernoulli(double p) {
+      return (*this)() < bernoulli_threshold(p) || p >= 1.0;
+    };
+
+    /**
+     * @brief    Fills draws[0, n) with Bernoulli(p) draws, e.g., to amortize the per-draw overhead in hot paths.
+     */
+    void fill_bernoulli(bool* draws, size_t n, double p);
+
+  private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); };
+
+    // Unbiased integer in [0, range) (Lemire's multiply-and-reject)
+    uint64_t bounded(uint64_t range) {
+      __uint128_t m = (__uint128_t) (*this)() * range;
+      uint64_t low = uint64_t(m);
+      if (low < range) {
+        uint64_t threshold = -range % range;
+        while (low < threshold) {
+          m = (__uint128_t) (*this)() * range;
+          low = uint64_t(m);
+        }
+      }
+      return uint64_t(m >> 64);
+    };
+
+    // A draw x is true iff x < p * 2^64
+    static uint64_t bernoulli_threshold(double p) {
+      if (p <= 0.0) {
+        return 0;
+      } else if (p >= 1.0) {
+        return max();
+      }
+      return uint64_t(p * 0x1.0p64);
+    };
+};
+
+
+/**
+ * @brief    Derives the independent random number streams of all components from one global seed.
+ * 
+ * @details
+ * The seed of a stream only depends on the global seed (the top-level "seed" of the configuration)
+ * and the path of the stream in the component tree (e.g., "MemorySystem.GenericDRAM/Controller.Generic[Channel 1]/..."),
+ * plus an optional per-stream offset (0 by default).
+ * Runs with the same configuration are therefore bit-for-bit reproducible, regardless of the order in which
+ * the components are created or how many other streams exist.
+ * 
+ */
+class RandomService {
+  private:
+    inline static uint64_t m_global_seed = 0;
+
+  public:
+    static void set_global_seed(uint64_t seed) { m_global_seed = seed; };
+    static uint64_t get_global_seed() { return m_global_seed; };
+
+    static uint64_t get_stream_seed(const std::string& path, uint64_t seed_offset = 0);
+    static RandomStream create_stream(const std::string& path, uint64_t seed_offset = 0) { return RandomStream(get_stream_seed(path, seed_offset)); };
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_BASE_RANDOM_H
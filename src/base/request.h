@@ -4,11 +4,55 @@
 #include <vector>
 #include <list>
 #include <string>
+#include <new>
+#include <cstddef>
+#include <type_traits>
 
 #include "base/base.h"
 
 namespace Ramulator {
 
+struct Request;
+
+/**
+ * @brief    The completion callback of a request, as a non-allocating, trivially copyable function object.
+ * 
+ * @details
+ * Holds a trivially copyable callable (e.g., a lambda capturing this and a few ids) of up to s_max_size bytes in
+ * place, with a pointer to a function that invokes it. Requests are copied through many queues, so copying a
+ * callback should cost a few words (unlike a std::function, which may allocate).
+ * 
+ */
+class RequestCallback {
+  public:
+    static constexpr size_t s_max_size = 3 * sizeof(void*);
+
+  private:
+    using Invoker_t = void (*)(const void* callable, Request& req);
+
+    alignas(std::max_align_t) unsigned char m_storage[s_max_size] = {};
+    Invoker_t m_invoker = nullptr;
+
+  public:
+    RequestCallback() = default;
+    RequestCallback(std::nullptr_t) {};
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, RequestCallback> &&
+                                                      !std::is_same_v<std::decay_t<F>, std::nullptr_t>>>
+    RequestCallback(const F& callable) {
+      static_assert(std::is_invocable_v<const F&, Request&>, "A request callback must be callable as callback(Request&).");
+      static_assert(std::is_trivially_copyable_v<F> && std::is_trivially_destructible_v<F>,
+                    "A request callback must be trivially copyable (e.g., a lambda capturing only pointers and ids).");
+      static_assert(sizeof(F) <= s_max_size && alignof(F) <= alignof(std::max_align_t),
+                    "A request callback must not be larger than RequestCallback::s_max_size.");
+      new (m_storage) F(callable);
+      m_invoker = [](const void* callable, Request& req) { (*static_cast<const F*>(callable))(req); };
+    };
+
+    void operator()(Request& req) const { m_invoker(m_storage, req); };
+    explicit operator bool() const { return m_invoker != nullptr; };
+};
+
 struct Request { 
   Addr_t    addr = -1;
   AddrVec_t addr_vec {};
@@ -24,25 +68,29 @@ struct Request {
 
   int type_id = -1;    // An identifier for the type of the request
   int source_id = -1;  // An identifier for where the request is coming from (e.g., which core)
+  int mitigation_id = -1;  // The RowHammer mitigation that issued the request, if any (see MitigationAccounting)
 
   int command = -1;          // The command that need to be issued to progress the request
   int final_command = -1;    // The final command that is needed to finish the request
   bool is_stat_updated = false; // Memory controller stats
 
   Clk_t arrive = -1;   // Clock cycle when the request arrive at the memory controller
+  Clk_t issue = -1;    // Clock cycle when the first command of the request is issued
   Clk_t depart = -1;   // Clock cycle when the request depart the memory controller
 
   std::array<int, 4> scratchpad = { 0 };    // A scratchpad for the request
 
-  std::function<void(Request&)> callback;
+  RequestCallback callback;
 
   void* m_payload = nullptr;    // Point to a generic payload
 
   Request(Addr_t addr, int type);
   Request(AddrVec_t addr_vec, int type);
-  Request(Addr_t addr, int type, int source_id, std::function<void(Request&)> callback);
+  Request(Addr_t addr, int type, int source_id, RequestCallback callback);
 };
 
+static_assert(std::is_trivially_copyable_v<RequestCallback>);
+
 
 struct ReqBuffer {
   std::list<Request> buffer;
@@ -0,0 +1,228 @@
+#include <map>
+#include <queue>
+#include <cstdint>
+#include <algorithm>
+
+#include "base/base.h"
+#include "base/stat_sampler.h"
+
+namespace Ramulator {
+
+namespace {
+
+bool match_wildcard(const std::string& pattern, const std::string& str) {
+  size_t p = 0, s = 0;
+  size_t star = std::string::npos, star_s = 0;
+  while (s < str.size()) {
+    if (p < pattern.size() && pattern[p] == '*') {
+      star = p++;
+      star_s = s;
+    } else if (p < pattern.size() && pattern[p] == str[s]) {
+      p++;
+      s++;
+    } else if (star != std::string::npos) {
+      // Let the last "*" absorb one more character
+      p = star + 1;
+      s = ++star_s;
+    } else {
+      return false;
+    }
+  }
+  while (p < pattern.size() && pattern[p] == '*') {
+    p++;
+  }
+  return p == pattern.size();
+}
+
+template <typename T>
+void write_raw(std::ofstream& out, const T* data, size_t count) {
+  out.write(reinterpret_cast<const char*>(data), sizeof(T) * count);
+}
+
+}        // namespace
+
+
+void StatSampler::init(Implementation* root) {
+  int interval = root->param<int>("sample_interval").desc("Sample the stats every this many cycles (0 disables sampling).").default_val(0);
+  if (interval < 0) {
+    throw ConfigurationError("[StatSampler] sample_interval must not be negative!");
+  }
+  if (interval == 0) {
+    return;
+  }
+
+  std::vector<std::string> patterns = root->param<std::vector<std::string>>("sample_stats").desc("Names of the sampled stats, \"*\" matches any characters.").default_val({"*"});
+  std::vector<double> percentiles = root->param<std::vector<double>>("sample_percentiles").desc("Percentiles sampled from the histogram stats in every epoch.").default_val({50.0, 99.0});
+  m_buffer_epochs = root->param<int>("sample_buffer_epochs").desc("Number of epochs buffered before they are written out.").default_val(1024);
+  m_output_path = root->param<std::string>("sample_output").desc("Path of the sample output file.").required();
+  std::string format = root->param<std::string>("sample_format").desc("\"csv\" or \"binary\".").default_val("csv");
+
+  if (format == "binary") {
+    m_is_binary = true;
+  } else if (format != "csv") {
+    throw ConfigurationError("[StatSampler] Unknown sample_format \"{}\"!", format);
+  }
+  if (m_buffer_epochs <= 0) {
+    throw ConfigurationError("[StatSampler] sample_buffer_epochs must be positive!");
+  }
+  for (double percentile : percentiles) {
+    if (percentile <= 0.0 || percentile > 100.0) {
+      throw ConfigurationError("[StatSampler] Invalid sample percentile ({})!", percentile);
+    }
+  }
+
+  // Collect the matching scalar and histogram stats in tree order, sorted by name within each component
+  struct Candidate {
+    std::string path;
+    const StatWrapperBase* stat;
+  };
+  std::vector<Candidate> candidates;
+  std::vector<bool> is_pattern_used(patterns.size(), false);
+  std::queue<const Implementation*> queue;
+  queue.push(root);
+  while (!queue.empty()) {
+    const Implementation* impl = queue.front();
+    queue.pop();
+    for (auto child : impl->get_children()) {
+      queue.push(child);
+    }
+
+    std::map<std::string, const StatWrapperBase*> stats;
+    for (auto [stat_name, stat_ptr] : impl->get_stats().get_registry()) {
+      if ((stat_ptr->is_scalar() || stat_ptr->get_histogram()) && !stat_ptr->is_computed_at_finalize()) {
+        stats[stat_name] = stat_ptr;
+      }
+    }
+    std::string path = impl->get_component_path();
+    for (auto [stat_name, stat_ptr] : stats) {
+      bool is_matched = false;
+      for (size_t i = 0; i < patterns.size(); i++) {
+        bool has_path = patterns[i].find('/') != std::string::npos;
+        if (match_wildcard(patterns[i], has_path ? path + "/" + stat_name : stat_name)) {
+          is_pattern_used[i] = true;
+          is_matched = true;
+        }
+      }
+      if (is_matched) {
+        candidates.push_back({path, stat_ptr});
+      }
+    }
+  }
+  for (size_t i = 0; i < patterns.size(); i++) {
+    if (!is_pattern_used[i]) {
+      throw ConfigurationError("[StatSampler] No stat that can be sampled matches \"{}\" (stats computed in finalize() cannot be sampled)!", patterns[i]);
+    }
+  }
+
+  std::map<std::string, int> name_counts;
+  for (const auto& candidate : candidates) {
+    name_counts[candidate.stat->get_name()]++;
+  }
+  for (const auto& candidate : candidates) {
+    const std::string& stat_name = candidate.stat->get_name();
+    std::string column_name = name_counts[stat_name] > 1 ? candidate.path + "/" + stat_name : stat_name;
+    if (const Histogram* histogram = candidate.stat->get_histogram()) {
+      for (double percentile : percentiles) {
+        m_columns.push_back({fmt::format("{}_p{}", column_name, percentile), candidate.stat, (int) m_histograms.size(), percentile});
+      }
+      m_histograms.push_back(histogram);
+      m_epoch_start_histograms.push_back(*histogram);
+    } else {
+      m_columns.push_back({column_name, candidate.stat});
+    }
+  }
+
+  m_clks.assign(m_buffer_epochs, 0);
+  m_values.assign((size_t) m_columns.size() * m_buffer_epochs, 0.0);
+
+  m_output.open(m_output_path, m_is_binary ? std::ios::out | std::ios::binary : std::ios::out);
+  if (!m_output.is_open()) {
+    throw ConfigurationError("[StatSampler] Cannot open {} for writing!", m_output_path);
+  }
+  write_header();
+
+  m_interval = interval;
+  m_next_sample_clk = m_interval;
+}
+
+void StatSampler::sample(Clk_t clk) {
+  int e = m_num_buffered;
+  m_clks[e] = clk;
+  for (size_t c = 0; c < m_columns.size(); c++) {
+    const Column& column = m_columns[c];
+    if (column.histogram == -1) {
+      m_values[c * m_buffer_epochs + e] = column.stat->get_value();
+    } else {
+      const Histogram& start = m_epoch_start_histograms[column.histogram];
+      m_values[c * m_buffer_epochs + e] = m_histograms[column.histogram]->get_percentile_since(start, column.percentile);
+    }
+  }
+  for (size_t h = 0; h < m_histograms.size(); h++) {
+    m_epoch_start_histograms[h] = *m_histograms[h];
+  }
+  if (++m_num_buffered == m_buffer_epochs) {
+    flush();
+  }
+  m_next_sample_clk += m_interval;
+}
+
+void StatSampler::write_header() {
+  if (m_is_binary) {
+    const uint32_t version = 1;
+    uint32_t num_columns = m_columns.size();
+    m_output.write("RSMP", 4);
+    write_raw(m_output, &version, 1);
+    write_raw(m_output, &num_columns, 1);
+    for (const auto& column : m_columns) {
+      uint32_t length = column.name.size();
+      write_raw(m_output, &length, 1);
+      m_output.write(column.name.data(), length);
+    }
+  } else {
+    m_output << "cycle";
+    for (const auto& column : m_columns) {
+      m_output << "," << column.name;
+    }
+    m_output << "\n";
+  }
+}
+
+void StatSampler::flush() {
+  if (m_num_buffered == 0) {
+    return;
+  }
+
+  if (m_is_binary) {
+    uint32_t num_epochs = m_num_buffered;
+    write_raw(m_output, &num_epochs, 1);
+    static_assert(sizeof(Clk_t) == sizeof(uint64_t));
+    write_raw(m_output, m_clks.data(), m_num_buffered);
+    for (size_t c = 0; c < m_columns.size(); c++) {
+      write_raw(m_output, &m_values[c * m_buffer_epochs], m_num_buffered);
+    }
+  } else {
+    fmt::memory_buffer buffer;
+    for (int e = 0; e < m_num_buffered; e++) {
+      fmt::format_to(std::back_inserter(buffer), "{}", m_clks[e]);
+      for (size_t c = 0; c < m_columns.size(); c++) {
+        fmt::format_to(std::back_inserter(buffer), ",{}", m_values[c * m_buffer_epochs + e]);
+      }
+      buffer.push_back('\n');
+    }
+    m_output.write(buffer.data(), buffer.size());
+  }
+  m_num_buffered = 0;
+}
+
+void StatSampler::finalize() {
+  if (m_interval == 0) {
+    return;
+  }
+  flush();
+  m_output.close();
+  if (m_output.fail()) {
+    throw std::runtime_error(fmt::format("[StatSampler] Failed to write {}!", m_output_path));
+  }
+}
+
+}        // namespace Ramulator
@@ -0,0 +1,91 @@
+#ifndef     RAMULATOR_BASE_STAT_SAMPLER_H
+#define     RAMULATOR_BASE_STAT_SAMPLER_H
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <fstream>
+
+#include "base/type.h"
+#include "base/histogram.h"
+
+namespace Ramulator {
+
+class Implementation;
+class StatWrapperBase;
+
+/**
+ * @brief    Records the values of selected stats every sample_interval cycles (an epoch) over the whole simulation.
+ *
+ * @details
+ * The sampled stats are the scalar and histogram stats of the component tree of the root whose names match
+ * sample_stats (exact names or "*" wildcards, matched against "<component path>/<name>" if the pattern contains a
+ * "/"). Stats that only get their value in finalize() (registered with computed_at_finalize(), e.g., averages) are
+ * never sampled. A column is named after its stat, prefixed by the component path if several components register a
+ * stat of the same name.
+ *
+ * A scalar stat is sampled as its current value, i.e., counters are cumulative and their rates over an epoch are
+ * the differences of consecutive samples. A histogram stat is sampled as one "<name>_p<percentile>" column per
+ * sample_percentiles, the percentile of the values recorded during the epoch (0 if there were none).
+ *
+ * Samples go into a preallocated columnar buffer of sample_buffer_epochs epochs, which is written out whenever it
+ * is full and at the end of the simulation, so the memory is bounded and sampling never allocates. sample_format
+ * selects the output:
+ *   csv:    a "cycle,<column>,..." header and one row per epoch.
+ *   binary: "RSMP", u32 version, u32 #columns, per column (u32 length, name); then per flushed buffer
+ *           u32 #epochs, #epochs x u64 cycle, and per column #epochs x f64 value (little-endian).
+ *
+ * Sampling is disabled by default (sample_interval = 0), and then tick() is a compare that never matches.
+ */
+class StatSampler {
+  public:
+    /**
+     * @brief    Reads the sampling parameters of root and resolves the columns in its component tree.
+     *
+     * Call it after all components are set up, so that all stats are registered.
+     */
+    void init(Implementation* root);
+
+    void tick(Clk_t clk) {
+      if (clk == m_next_sample_clk) {
+        sample(clk);
+      }
+    };
+
+    /**
+     * @brief    Writes out the remaining samples and closes the output.
+     */
+    void finalize();
+
+  private:
+    struct Column {
+      std::string name;
+      const StatWrapperBase* stat;
+      int histogram = -1;           // Index into m_histograms of a percentile column, -1 for a scalar stat
+      double percentile = 0.0;
+    };
+
+    Clk_t m_interval = 0;
+    Clk_t m_next_sample_clk = std::numeric_limits<Clk_t>::max();
+
+    bool m_is_binary = false;
+    std::string m_output_path;
+    std::ofstream m_output;
+
+    std::vector<Column> m_columns;
+    std::vector<const Histogram*> m_histograms;
+    std::vector<Histogram> m_epoch_start_histograms;   // Copies of m_histograms at the previous sample
+    int m_buffer_epochs = 0;
+    int m_num_buffered = 0;
+    std::vector<Clk_t> m_clks;          // [epoch]
+    std::vector<double> m_values;       // [column][epoch]
+
+    void sample(Clk_t clk);
+    void flush();
+    void write_header();
+};
+
+}        // namespace Ramulator
+
+
+#endif   // RAMULATOR_BASE_STAT_SAMPLER_H
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "base/stats.h"
 
 namespace Ramulator {
@@ -9,4 +11,12 @@ YAML::Emitter& operator << (YAML::Emitter& emitter, const Stats& s) {
 	return emitter;
 }
 
+void Stats::write_to(StatsSink& sink, const std::string& path) const {
+  std::vector<std::pair<std::string, StatWrapperBase*>> stats(_registry.begin(), _registry.end());
+  std::sort(stats.begin(), stats.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+  for (auto [stat_name, stat_ptr] : stats) {
+    stat_ptr->write_to(sink, path);
+  }
+}
+
 }        // namespace Ramulator
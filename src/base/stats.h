@@ -4,12 +4,15 @@
 #include <vector>
 #include <string>
 #include <variant>
+#include <type_traits>
 
 #include <spdlog/spdlog.h>
 #include <yaml-cpp/yaml.h>
 
 #include "base/type.h"
 #include "base/exception.h"
+#include "base/histogram.h"
+#include "base/stats_sink.h"
 
 
 namespace Ramulator {
@@ -18,6 +21,24 @@ class Implementation;
 class StatWrapperBase {
   public:
     virtual void emit_to(YAML::Emitter& emitter) = 0;
+    /**
+     * @brief    Writes the stat to sink with the key "<path>/<name>".
+     */
+    virtual void write_to(StatsSink& sink, const std::string& path) = 0;
+    virtual const std::string& get_name() const = 0;
+    /**
+     * @brief    Whether the stat is a single arithmetic value, i.e., can be sampled with get_value().
+     */
+    virtual bool is_scalar() const = 0;
+    virtual double get_value() const = 0;
+    /**
+     * @brief    The histogram of a single Histogram stat, or nullptr.
+     */
+    virtual const Histogram* get_histogram() const = 0;
+    /**
+     * @brief    Whether the stat only gets its value in finalize() (e.g., an average), so it cannot be sampled.
+     */
+    virtual bool is_computed_at_finalize() const = 0;
 };
 
 template<typename T>
@@ -35,6 +56,15 @@ class Stats {
     bool is_empty() {
       return _registry.size() == 0;
     }
+
+    const Registry_t<StatWrapperBase*>& get_registry() const {
+      return _registry;
+    }
+
+    /**
+     * @brief    Writes all stats (sorted by name) to sink, keyed under path.
+     */
+    void write_to(StatsSink& sink, const std::string& path) const;
 };
 
 
@@ -44,8 +74,12 @@ class StatWrapper : public StatWrapperBase {
 
   private:
     std::variant<T*, std::vector<T>*> _ref;
+    // The type arithmetic stats are written to a StatsSink as
+    using SinkValue_t = std::conditional_t<std::is_floating_point_v<T>, double,
+                        std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
     std::string _name;
     std::string _desc;
+    bool _is_computed_at_finalize = false;
 
     const Implementation& _impl;
     Stats& _stats;
@@ -68,6 +102,61 @@ class StatWrapper : public StatWrapperBase {
     };
     
     StatWrapper& desc(std::string desc) { _desc = desc; return *this; };
+    StatWrapper& computed_at_finalize() { _is_computed_at_finalize = true; return *this; };
+
+    const std::string& get_name() const override { return _name; };
+
+    bool is_scalar() const override {
+      if constexpr (std::is_arithmetic_v<T>) {
+        return std::holds_alternative<T*>(_ref);
+      } else {
+        return false;
+      }
+    };
+
+    void write_to(StatsSink& sink, const std::string& path) override {
+      static_assert(std::is_arithmetic_v<T> || std::is_same_v<T, Histogram> || std::is_same_v<T, std::string>,
+                    "Stats written to a StatsSink must be arithmetic, Histogram or std::string!");
+      std::string key = path + "/" + _name;
+      if (std::holds_alternative<T*>(_ref)) {
+        const T& val = *(std::get<T*>(_ref));
+        if constexpr (std::is_arithmetic_v<T>) {
+          sink.write(key, _desc, (SinkValue_t) val);
+        } else {
+          sink.write(key, _desc, val);
+        }
+      } else {
+        const std::vector<T>& vals = *(std::get<std::vector<T>*>(_ref));
+        if constexpr (std::is_arithmetic_v<T>) {
+          sink.write(key, _desc, std::vector<SinkValue_t>(vals.begin(), vals.end()));
+        } else if constexpr (std::is_same_v<T, Histogram>) {
+          for (size_t i = 0; i < vals.size(); i++) {
+            sink.write(fmt::format("{}[{}]", key, i), _desc, vals[i]);
+          }
+        } else {
+          sink.write(key, _desc, vals);
+        }
+      }
+    };
+
+    double get_value() const override {
+      if constexpr (std::is_arithmetic_v<T>) {
+        return (double) *(std::get<T*>(_ref));
+      } else {
+        return 0.0;
+      }
+    };
+
+    const Histogram* get_histogram() const override {
+      if constexpr (std::is_same_v<T, Histogram>) {
+        if (std::holds_alternative<T*>(_ref)) {
+          return std::get<T*>(_ref);
+        }
+      }
+      return nullptr;
+    };
+
+    bool is_computed_at_finalize() const override { return _is_computed_at_finalize; };
 
     void emit_to(YAML::Emitter& emitter) override {
       if        (std::holds_alternative<T*>(_ref)) {
@@ -82,7 +171,7 @@ class StatWrapper : public StatWrapperBase {
           emitter << YAML::Comment(_desc);
         }
         emitter << YAML::Value <<  YAML::BeginSeq;
-        for (const auto _val : *(std::get<std::vector<T>*>(_ref))) {
+        for (const auto& _val : *(std::get<std::vector<T>*>(_ref))) {
           emitter << _val;
         }
         emitter << YAML::EndSeq;
@@ -0,0 +1,268 @@
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+
+#include "base/stats_sink.h"
+#include "base/exception.h"
+
+namespace Ramulator {
+
+namespace {
+
+class FileStatsSink : public StatsSink {
+  protected:
+    std::string m_path;
+    std::ofstream m_file;
+
+  public:
+    FileStatsSink(const std::string& path, bool is_binary) : m_path(path) {
+      m_file.open(path, is_binary ? std::ios::out | std::ios::binary : std::ios::out);
+      if (!m_file.is_open()) {
+        throw ConfigurationError("Cannot open stats file {} for writing!", path);
+      }
+    };
+
+    void close() override {
+      finish();
+      m_file.close();
+      if (m_file.fail()) {
+        throw std::runtime_error(fmt::format("Failed to write stats file {}!", m_path));
+      }
+    };
+
+  protected:
+    virtual void finish() = 0;
+};
+
+
+class JSONStatsSink final : public FileStatsSink {
+  private:
+    fmt::memory_buffer m_buffer;
+    bool m_is_first = true;
+
+  public:
+    JSONStatsSink(const std::string& path) : FileStatsSink(path, false) {
+      m_file << "{\"format\": \"ramulator-stats\", \"version\": 1, \"stats\": {";
+    };
+
+    void write(const std::string& key, const std::string& desc, int64_t value) override {
+      begin(key, desc, "int64");
+      fmt::format_to(out(), "{}", value);
+      end();
+    };
+    void write(const std::string& key, const std::string& desc, uint64_t value) override {
+      begin(key, desc, "uint64");
+      fmt::format_to(out(), "{}", value);
+      end();
+    };
+    void write(const std::string& key, const std::string& desc, double value) override {
+      begin(key, desc, "double");
+      write_double(value);
+      end();
+    };
+    void write(const std::string& key, const std::string& desc, const std::vector<int64_t>& values) override {
+      begin(key, desc, "int64[]");
+      fmt::format_to(out(), "[{}]", fmt::join(values, ", "));
+      end();
+    };
+    void write(const std::string& key, const std::string& desc, const std::vector<uint64_t>& values) override {
+      begin(key, desc, "uint64[]");
+      fmt::format_to(out(), "[{}]", fmt::join(values, ", "));
+      end();
+    };
+    void write(const std::string& key, const std::string& desc, const std::vector<double>& values) override {
+      begin(key, desc, "double[]");
+      m_buffer.push_back('[');
+      for (size_t i = 0; i < values.size(); i++) {
+        if (i != 0) {
+          fmt::format_to(out(), ", ");
+        }
+        write_double(values[i]);
+      }
+      m_buffer.push_back(']');
+      end();
+    };
+    void write(const std::string& key, const std::string& desc, const Histogram& histogram) override {
+      begin(key, desc, "histogram");
+      fmt::format_to(out(), "{{\"count\": {}, \"mean\": ", histogram.get_count());
+      write_double(histogram.get_mean());
+      fmt::format_to(out(), ", \"min\": {}, \"p50\": {}, \"p90\": {}, \"p99\": {}, \"p99.9\": {}, \"max\": {}}}",
+                     histogram.get_min(), histogram.get_percentile(50.0), histogram.get_percentile(90.0),
+                     histogram.get_percentile(99.0), histogram.get_percentile(99.9), histogram.get_max());
+      end();
+    };
+    void write(const std::string& key, const std::string& desc, const std::string& value) override {
+      begin(key, desc, "string");
+      write_string(value);
+      end();
+    };
+    void write(const std::string& key, const std::string& desc, const std::vector<std::string>& values) override {
+      begin(key, desc, "string[]");
+      m_buffer.push_back('[');
+      for (size_t i = 0; i < values.size(); i++) {
+        if (i != 0) {
+          fmt::format_to(out(), ", ");
+        }
+        write_string(values[i]);
+      }
+      m_buffer.push_back(']');
+      end();
+    };
+
+  private:
+    std::back_insert_iterator<fmt::memory_buffer> out() { return std::back_inserter(m_buffer); };
+
+    void begin(const std::string& key, const std::string& desc, const char* type) {
+      m_buffer.clear();
+      if (!m_is_first) {
+        m_buffer.push_back(',');
+      }
+      m_is_first = false;
+      fmt::format_to(out(), "\n  ");
+      write_string(key);
+      fmt::format_to(out(), ": {{\"type\": \"{}\", \"desc\": ", type);
+      write_string(desc);
+      fmt::format_to(out(), ", \"value\": ");
+    };
+
+    void end() {
+      m_buffer.push_back('}');
+      m_file.write(m_buffer.data(), m_buffer.size());
+    };
+
+    void write_double(double value) {
+      if (std::isfinite(value)) {
+        fmt::format_to(out(), "{}", value);
+      } else {
+        fmt::format_to(out(), "null");
+      }
+    };
+
+    void write_string(const std::string& str) {
+      m_buffer.push_back('"');
+      for (char c : str) {
+        switch (c) {
+          case '"':  fmt::format_to(out(), "\\\""); break;
+          case '\\': fmt::format_to(out(), "\\\\"); break;
+          case '\n': fmt::format_to(out(), "\\n");  break;
+          case '\t': fmt::format_to(out(), "\\t");  break;
+          default:
+            if ((unsigned char) c < 0x20) {
+              fmt::format_to(out(), "\\u{:04x}", (int) c);
+            } else {
+              m_buffer.push_back(c);
+            }
+        }
+      }
+      m_buffer.push_back('"');
+    };
+
+    void finish() override {
+      m_file << "\n}}\n";
+    };
+};
+
+
+class BinaryStatsSink final : public FileStatsSink {
+  public:
+    BinaryStatsSink(const std::string& path) : FileStatsSink(path, true) {
+      const uint32_t version = 1;
+      m_file.write("RSTS", 4);
+      write_raw(version);
+    };
+
+    void write(const std::string& key, const std::string& desc, int64_t value) override {
+      begin(key, desc, Type::INT64);
+      write_raw(value);
+    };
+    void write(const std::string& key, const std::string& desc, uint64_t value) override {
+      begin(key, desc, Type::UINT64);
+      write_raw(value);
+    };
+    void write(const std::string& key, const std::string& desc, double value) override {
+      begin(key, desc, Type::DOUBLE);
+      write_raw(value);
+    };
+    void write(const std::string& key, const std::string& desc, const std::vector<int64_t>& values) override {
+      begin(key, desc, Type::INT64_ARRAY);
+      write_array(values);
+    };
+    void write(const std::string& key, const std::string& desc, const std::vector<uint64_t>& values) override {
+      begin(key, desc, Type::UINT64_ARRAY);
+      write_array(values);
+    };
+    void write(const std::string& key, const std::string& desc, const std::vector<double>& values) override {
+      begin(key, desc, Type::DOUBLE_ARRAY);
+      write_array(values);
+    };
+    void write(const std::string& key, const std::string& desc, const Histogram& histogram) override {
+      begin(key, desc, Type::HISTOGRAM);
+      write_raw(histogram.get_count());
+      write_raw(histogram.get_mean());
+      write_raw(histogram.get_min());
+      for (double percentile : {50.0, 90.0, 99.0, 99.9}) {
+        write_raw(histogram.get_percentile(percentile));
+      }
+      write_raw(histogram.get_max());
+    };
+    void write(const std::string& key, const std::string& desc, const std::string& value) override {
+      begin(key, desc, Type::STRING);
+      write_string(value);
+    };
+    void write(const std::string& key, const std::string& desc, const std::vector<std::string>& values) override {
+      begin(key, desc, Type::STRING_ARRAY);
+      write_raw((uint32_t) values.size());
+      for (const std::string& value : values) {
+        write_string(value);
+      }
+    };
+
+  private:
+    template <typename T>
+    void write_raw(const T& value) {
+      m_file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    };
+
+    template <typename T>
+    void write_array(const std::vector<T>& values) {
+      write_raw((uint32_t) values.size());
+      m_file.write(reinterpret_cast<const char*>(values.data()), sizeof(T) * values.size());
+    };
+
+    void write_string(const std::string& str) {
+      write_raw((uint32_t) str.size());
+      m_file.write(str.data(), str.size());
+    };
+
+    void begin(const std::string& key, const std::string& desc, Type type) {
+      write_raw((uint8_t) type);
+      write_string(key);
+      write_string(desc);
+    };
+
+    void finish() override {};
+};
+
+}        // namespace
+
+
+void StatsSink::open(const std::string& path, const std::string& format) {
+  if (format == "json") {
+    s_sink = std::make_unique<JSONStatsSink>(path);
+  } else if (format == "binary") {
+    s_sink = std::make_unique<BinaryStatsSink>(path);
+  } else {
+    throw ConfigurationError("Unknown stats format \"{}\"!", format);
+  }
+}
+
+void StatsSink::close_sink() {
+  if (s_sink) {
+    s_sink->close();
+    s_sink.reset();
+  }
+}
+
+}        // namespace Ramulator
@@ -0,0 +1,74 @@
+#ifndef     RAMULATOR_BASE_STATS_SINK_H
+#define     RAMULATOR_BASE_STATS_SINK_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+#include "base/histogram.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    A machine-readable destination for the final stats, as an alternative to the YAML on stdout.
+ *
+ * @details
+ * Every stat is written with its full key "<component path>/<stat name>" (e.g.,
+ * "MemorySystem.GenericDRAM/Controller.Generic[Channel 0]/row_hits_0"), its description, and a typed value.
+ * Integral stats are written as int64/uint64, floating-point stats as double, string stats as strings, vector stats
+ * as arrays, and histograms as their summary (count, mean, min, p50, p90, p99, p99.9, max).
+ *
+ * The sink of the simulation is opened from the command line (--stats_file) and shared by the frontend and
+ * the memory system: when it is open, their finalize() writes to it instead of printing YAML.
+ *
+ * Formats:
+ *   json:   {"format": "ramulator-stats", "version": 1, "stats": {"<key>": {"type": ..., "desc": ..., "value": ...}, ...}}
+ *           Non-finite floating-point values are written as null.
+ *   binary: "RSTS", u32 version; then per stat: u8 type, u32 length + key, u32 length + desc, value (little-endian):
+ *           INT64/UINT64/DOUBLE: 8 bytes; *_ARRAY: u32 count + count x 8 bytes;
+ *           HISTOGRAM: u64 count, f64 mean, u64 min, p50, p90, p99, p99.9, max;
+ *           STRING: u32 length + bytes; STRING_ARRAY: u32 count + count x (u32 length + bytes).
+ *
+ */
+class StatsSink {
+  public:
+    enum class Type : uint8_t {
+      INT64 = 0, UINT64, DOUBLE, INT64_ARRAY, UINT64_ARRAY, DOUBLE_ARRAY, HISTOGRAM, STRING, STRING_ARRAY,
+    };
+
+    virtual ~StatsSink() = default;
+
+    virtual void write(const std::string& key, const std::string& desc, int64_t value) = 0;
+    virtual void write(const std::string& key, const std::string& desc, uint64_t value) = 0;
+    virtual void write(const std::string& key, const std::string& desc, double value) = 0;
+    virtual void write(const std::string& key, const std::string& desc, const std::vector<int64_t>& values) = 0;
+    virtual void write(const std::string& key, const std::string& desc, const std::vector<uint64_t>& values) = 0;
+    virtual void write(const std::string& key, const std::string& desc, const std::vector<double>& values) = 0;
+    virtual void write(const std::string& key, const std::string& desc, const Histogram& histogram) = 0;
+    virtual void write(const std::string& key, const std::string& desc, const std::string& value) = 0;
+    virtual void write(const std::string& key, const std::string& desc, const std::vector<std::string>& values) = 0;
+
+    /**
+     * @brief    Finishes the output. Throws if it could not be written.
+     */
+    virtual void close() = 0;
+
+    /**
+     * @brief    Opens the sink of the simulation. format is "json" or "binary".
+     */
+    static void open(const std::string& path, const std::string& format);
+    /**
+     * @brief    Returns the sink of the simulation, or nullptr if the stats go to stdout.
+     */
+    static StatsSink* get() { return s_sink.get(); };
+    static void close_sink();
+
+  private:
+    inline static std::unique_ptr<StatsSink> s_sink = nullptr;
+};
+
+}        // namespace Ramulator
+
+
+#endif   // RAMULATOR_BASE_STATS_SINK_H
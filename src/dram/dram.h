@@ -73,6 +73,18 @@ class IDRAM : public Clocked<IDRAM> {
 
     bool m_power_debug = false;
 
+    int m_power_opened_state = -1;              // The bank states counted as open/refreshing by the power stats
+    int m_power_refreshing_state = -1;
+
+    /**
+     * @brief   Updates the open/refreshing bank counters of a rank when one of its banks changes state.
+     */
+    void track_bank_power_state(int flat_rank_id, int old_state, int new_state) {
+      PowerStats& rank_stats = m_power_stats[flat_rank_id];
+      rank_stats.num_open_banks += (new_state == m_power_opened_state) - (old_state == m_power_opened_state);
+      rank_stats.num_refreshing_banks += (new_state == m_power_refreshing_state) - (old_state == m_power_refreshing_state);
+    };
+
     double s_total_background_energy = 0; // Total background energy consumed by the device
     double s_total_cmd_energy = 0;        // Total command energy consumed by the device
     double s_total_energy = 0;            // Total energy consumed by the device
@@ -683,18 +683,18 @@ class DDR4RVRR : public IDRAM, public Implementation {
       m_powers[m_levels["rank"]][m_commands["RVRR_end"]] = Lambdas::Power::Rank::VRR_end<DDR4RVRR>;
 
       // register stats
-      register_stat(s_total_background_energy).name("total_background_energy");
-      register_stat(s_total_cmd_energy).name("total_cmd_energy");
-      register_stat(s_total_energy).name("total_energy");
-      register_stat(s_total_vrr_energy).name("total_vrr_energy");
-      register_stat(s_total_rvrr_energy).name("total_rvrr_energy");
+      register_stat(s_total_background_energy).name("total_background_energy").computed_at_finalize();
+      register_stat(s_total_cmd_energy).name("total_cmd_energy").computed_at_finalize();
+      register_stat(s_total_energy).name("total_energy").computed_at_finalize();
+      register_stat(s_total_vrr_energy).name("total_vrr_energy").computed_at_finalize();
+      register_stat(s_total_rvrr_energy).name("total_rvrr_energy").computed_at_finalize();
 
       for (auto& power_stat : m_power_stats){
-        register_stat(power_stat.total_background_energy).name("total_background_energy_rank{}", power_stat.rank_id);
-        register_stat(power_stat.total_cmd_energy).name("total_cmd_energy_rank{}", power_stat.rank_id);
-        register_stat(power_stat.total_energy).name("total_energy_rank{}", power_stat.rank_id);
-        register_stat(power_stat.act_background_energy).name("act_background_energy_rank{}", power_stat.rank_id);
-        register_stat(power_stat.pre_background_energy).name("pre_background_energy_rank{}", power_stat.rank_id);
+        register_stat(power_stat.total_background_energy).name("total_background_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.total_cmd_energy).name("total_cmd_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.total_energy).name("total_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.act_background_energy).name("act_background_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.pre_background_energy).name("pre_background_energy_rank{}", power_stat.rank_id).computed_at_finalize();
         register_stat(power_stat.active_cycles).name("active_cycles_rank{}", power_stat.rank_id);
         register_stat(power_stat.idle_cycles).name("idle_cycles_rank{}", power_stat.rank_id);
       }
@@ -706,6 +706,10 @@ class DDR4RVRR : public IDRAM, public Implementation {
         Node* channel = new Node(this, nullptr, 0, i);
         m_channels.push_back(channel);
       }
+
+      if (m_drampower_enable) {
+        Lambdas::Power::Rank::init_trackers<DDR4RVRR>(this, m_channels);
+      }
     }
 
     void finalize() override {
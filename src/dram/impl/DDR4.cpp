@@ -24,31 +24,31 @@ class DDR4 : public IDRAM, public Implementation {
     };
 
     inline static const std::map<std::string, std::vector<int>> timing_presets = {
-      //   name       rate   nBL  nCL  nRCD  nRP   nRAS  nRC   nWR  nRTP nCWL nCCDS nCCDL nRRDS nRRDL nWTRS nWTRL nFAW  nRFC nREFI nCS,  tCK_ps
-      {"DDR4_1600J",  {1600,   4,  10,  10,   10,   28,   38,   12,   6,   9,    4,    5,   -1,   -1,    2,    6,   -1,  -1,  -1,   2,    1250}},
-      {"DDR4_1600K",  {1600,   4,  11,  11,   11,   28,   39,   12,   6,   9,    4,    5,   -1,   -1,    2,    6,   -1,  -1,  -1,   2,    1250}},
-      {"DDR4_1600L",  {1600,   4,  12,  12,   12,   28,   40,   12,   6,   9,    4,    5,   -1,   -1,    2,    6,   -1,  -1,  -1,   2,    1250}},
-      {"DDR4_1866L",  {1866,   4,  12,  12,   12,   32,   44,   14,   7,   10,   4,    5,   -1,   -1,    3,    7,   -1,  -1,  -1,   2,    1071}},
-      {"DDR4_1866M",  {1866,   4,  13,  13,   13,   32,   45,   14,   7,   10,   4,    5,   -1,   -1,    3,    7,   -1,  -1,  -1,   2,    1071}},
-      {"DDR4_1866N",  {1866,   4,  14,  14,   14,   32,   46,   14,   7,   10,   4,    5,   -1,   -1,    3,    7,   -1,  -1,  -1,   2,    1071}},
-      {"DDR4_2133N",  {2133,   4,  14,  14,   14,   36,   50,   16,   8,   11,   4,    6,   -1,   -1,    3,    8,   -1,  -1,  -1,   2,    937} },
-      {"DDR4_2133P",  {2133,   4,  15,  15,   15,   36,   51,   16,   8,   11,   4,    6,   -1,   -1,    3,    8,   -1,  -1,  -1,   2,    937} },
-      {"DDR4_2133R",  {2133,   4,  16,  16,   16,   36,   52,   16,   8,   11,   4,    6,   -1,   -1,    3,    8,   -1,  -1,  -1,   2,    937} },
-      {"DDR4_2400P",  {2400,   4,  15,  15,   15,   39,   54,   18,   9,   12,   4,    6,   -1,   -1,    3,    9,   -1,  -1,  -1,   2,    833} },
-      {"DDR4_2400R",  {2400,   4,  16,  16,   16,   39,   55,   18,   9,   12,   4,    6,   -1,   -1,    3,    9,   -1,  -1,  -1,   2,    833} },
-      {"DDR4_2400U",  {2400,   4,  17,  17,   17,   39,   56,   18,   9,   12,   4,    6,   -1,   -1,    3,    9,   -1,  -1,  -1,   2,    833} },
-      {"DDR4_2400T",  {2400,   4,  18,  18,   18,   39,   57,   18,   9,   12,   4,    6,   -1,   -1,    3,    9,   -1,  -1,  -1,   2,    833} },
-      {"DDR4_2666T",  {2666,   4,  17,  17,   17,   43,   60,   20,   10,  14,   4,    7,   -1,   -1,    4,    10,  -1,  -1,  -1,   2,    750} },
-      {"DDR4_2666U",  {2666,   4,  18,  18,   18,   43,   61,   20,   10,  14,   4,    7,   -1,   -1,    4,    10,  -1,  -1,  -1,   2,    750} },
-      {"DDR4_2666V",  {2666,   4,  19,  19,   19,   43,   62,   20,   10,  14,   4,    7,   -1,   -1,    4,    10,  -1,  -1,  -1,   2,    750} },
-      {"DDR4_2666W",  {2666,   4,  20,  20,   20,   43,   63,   20,   10,  14,   4,    7,   -1,   -1,    4,    10,  -1,  -1,  -1,   2,    750} },
-      {"DDR4_2933V",  {2933,   4,  19,  19,   19,   47,   66,   22,   11,  16,   4,    8,   -1,   -1,    4,    11,  -1,  -1,  -1,   2,    682} },
-      {"DDR4_2933W",  {2933,   4,  20,  20,   20,   47,   67,   22,   11,  16,   4,    8,   -1,   -1,    4,    11,  -1,  -1,  -1,   2,    682} },
-      {"DDR4_2933Y",  {2933,   4,  21,  21,   21,   47,   68,   22,   11,  16,   4,    8,   -1,   -1,    4,    11,  -1,  -1,  -1,   2,    682} },
-      {"DDR4_2933AA", {2933,   4,  22,  22,   22,   47,   69,   22,   11,  16,   4,    8,   -1,   -1,    4,    11,  -1,  -1,  -1,   2,    682} },
-      {"DDR4_3200W",  {3200,   4,  20,  20,   20,   52,   72,   24,   12,  16,   4,    8,   -1,   -1,    4,    12,  -1,  -1,  -1,   2,    625} },
-      {"DDR4_3200AA", {3200,   4,  22,  22,   22,   52,   74,   24,   12,  16,   4,    8,   -1,   -1,    4,    12,  -1,  -1,  -1,   2,    625} },
-      {"DDR4_3200AC", {3200,   4,  24,  24,   24,   52,   76,   24,   12,  16,   4,    8,   -1,   -1,    4,    12,  -1,  -1,  -1,   2,    625} },
+      //   name       rate   nBL  nCL  nRCD  nRP   nRAS  nRC   nWR  nRTP nCWL nCCDS nCCDL nRRDS nRRDL nWTRS nWTRL nFAW  nRFC nREFI nCS,  nXP  nPD  nXS  nSR  tCK_ps
+      {"DDR4_1600J",  {1600,   4,  10,  10,   10,   28,   38,   12,   6,   9,    4,    5,   -1,   -1,    2,    6,   -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    1250}},
+      {"DDR4_1600K",  {1600,   4,  11,  11,   11,   28,   39,   12,   6,   9,    4,    5,   -1,   -1,    2,    6,   -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    1250}},
+      {"DDR4_1600L",  {1600,   4,  12,  12,   12,   28,   40,   12,   6,   9,    4,    5,   -1,   -1,    2,    6,   -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    1250}},
+      {"DDR4_1866L",  {1866,   4,  12,  12,   12,   32,   44,   14,   7,   10,   4,    5,   -1,   -1,    3,    7,   -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    1071}},
+      {"DDR4_1866M",  {1866,   4,  13,  13,   13,   32,   45,   14,   7,   10,   4,    5,   -1,   -1,    3,    7,   -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    1071}},
+      {"DDR4_1866N",  {1866,   4,  14,  14,   14,   32,   46,   14,   7,   10,   4,    5,   -1,   -1,    3,    7,   -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    1071}},
+      {"DDR4_2133N",  {2133,   4,  14,  14,   14,   36,   50,   16,   8,   11,   4,    6,   -1,   -1,    3,    8,   -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    937} },
+      {"DDR4_2133P",  {2133,   4,  15,  15,   15,   36,   51,   16,   8,   11,   4,    6,   -1,   -1,    3,    8,   -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    937} },
+      {"DDR4_2133R",  {2133,   4,  16,  16,   16,   36,   52,   16,   8,   11,   4,    6,   -1,   -1,    3,    8,   -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    937} },
+      {"DDR4_2400P",  {2400,   4,  15,  15,   15,   39,   54,   18,   9,   12,   4,    6,   -1,   -1,    3,    9,   -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    833} },
+      {"DDR4_2400R",  {2400,   4,  16,  16,   16,   39,   55,   18,   9,   12,   4,    6,   -1,   -1,    3,    9,   -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    833} },
+      {"DDR4_2400U",  {2400,   4,  17,  17,   17,   39,   56,   18,   9,   12,   4,    6,   -1,   -1,    3,    9,   -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    833} },
+      {"DDR4_2400T",  {2400,   4,  18,  18,   18,   39,   57,   18,   9,   12,   4,    6,   -1,   -1,    3,    9,   -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    833} },
+      {"DDR4_2666T",  {2666,   4,  17,  17,   17,   43,   60,   20,   10,  14,   4,    7,   -1,   -1,    4,    10,  -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    750} },
+      {"DDR4_2666U",  {2666,   4,  18,  18,   18,   43,   61,   20,   10,  14,   4,    7,   -1,   -1,    4,    10,  -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    750} },
+      {"DDR4_2666V",  {2666,   4,  19,  19,   19,   43,   62,   20,   10,  14,   4,    7,   -1,   -1,    4,    10,  -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    750} },
+      {"DDR4_2666W",  {2666,   4,  20,  20,   20,   43,   63,   20,   10,  14,   4,    7,   -1,   -1,    4,    10,  -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    750} },
+      {"DDR4_2933V",  {2933,   4,  19,  19,   19,   47,   66,   22,   11,  16,   4,    8,   -1,   -1,    4,    11,  -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    682} },
+      {"DDR4_2933W",  {2933,   4,  20,  20,   20,   47,   67,   22,   11,  16,   4,    8,   -1,   -1,    4,    11,  -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    682} },
+      {"DDR4_2933Y",  {2933,   4,  21,  21,   21,   47,   68,   22,   11,  16,   4,    8,   -1,   -1,    4,    11,  -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    682} },
+      {"DDR4_2933AA", {2933,   4,  22,  22,   22,   47,   69,   22,   11,  16,   4,    8,   -1,   -1,    4,    11,  -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    682} },
+      {"DDR4_3200W",  {3200,   4,  20,  20,   20,   52,   72,   24,   12,  16,   4,    8,   -1,   -1,    4,    12,  -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    625} },
+      {"DDR4_3200AA", {3200,   4,  22,  22,   22,   52,   74,   24,   12,  16,   4,    8,   -1,   -1,    4,    12,  -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    625} },
+      {"DDR4_3200AC", {3200,   4,  24,  24,   24,   52,   76,   24,   12,  16,   4,    8,   -1,   -1,    4,    12,  -1,  -1,  -1,   2,   -1,   -1,   -1,   -1,    625} },
     };
 
     inline static const std::map<std::string, std::vector<double>> voltage_presets = {
@@ -57,8 +57,8 @@ class DDR4 : public IDRAM, public Implementation {
     };
 
     inline static const std::map<std::string, std::vector<double>> current_presets = {
-      // name           IDD0  IDD2N   IDD3N   IDD4R   IDD4W   IDD5B   IPP0  IPP2N  IPP3N  IPP4R  IPP4W  IPP5B
-      {"Default",       {60,   50,     55,     145,    145,    362,     3,    3,     3,     3,     3,     48}},
+      // name           IDD0  IDD2N   IDD3N   IDD4R   IDD4W   IDD5B   IDD2P   IDD3P   IDD6N   IPP0  IPP2N  IPP3N  IPP4R  IPP4W  IPP5B  IPP2P  IPP3P  IPP6N
+      {"Default",       {60,   50,     55,     145,    145,    362,    25,     37,     30,      3,    3,     3,     3,     3,     48,    3,     3,     4}},
     };
 
   /************************************************
@@ -78,7 +78,8 @@ class DDR4 : public IDRAM, public Implementation {
       "ACT", 
       "PRE", "PREA",
       "RD",  "WR",  "RDA",  "WRA",
-      "REFab", "REFab_end"
+      "REFab", "REFab_end",
+      "PDE", "PDX", "SRE", "SRX"
     };
 
     inline static const ImplLUT m_command_scopes = LUT (
@@ -87,6 +88,7 @@ class DDR4 : public IDRAM, public Implementation {
         {"PRE",   "bank"},   {"PREA",   "rank"},
         {"RD",    "column"}, {"WR",     "column"}, {"RDA",   "column"}, {"WRA",   "column"},
         {"REFab", "rank"},  {"REFab_end", "rank"},
+        {"PDE",   "rank"},  {"PDX",   "rank"},     {"SRE",   "rank"},   {"SRX",   "rank"},
       }
     );
 
@@ -102,17 +104,23 @@ class DDR4 : public IDRAM, public Implementation {
         {"WRA",       {false,  true,    true,    false}},
         {"REFab",     {false,  false,   false,   true }},
         {"REFab_end", {false,  true,    false,   false}},
+        {"PDE",       {false,  false,   false,   false}},
+        {"PDX",       {false,  false,   false,   false}},
+        {"SRE",       {false,  false,   false,   false}},
+        {"SRX",       {false,  false,   false,   false}},
       }
     );
 
     inline static constexpr ImplDef m_requests = {
-      "read", "write", "all-bank-refresh", "open-row", "close-row"
+      "read", "write", "all-bank-refresh", "open-row", "close-row",
+      "power-down", "self-refresh"
     };
 
     inline static const ImplLUT m_request_translations = LUT (
       m_requests, m_commands, {
         {"read", "RD"}, {"write", "WR"}, {"all-bank-refresh", "REFab"},
-        {"open-row", "ACT"}, {"close-row", "PRE"}
+        {"open-row", "ACT"}, {"close-row", "PRE"},
+        {"power-down", "PDE"}, {"self-refresh", "SRE"}
       }
     );
 
@@ -129,6 +137,7 @@ class DDR4 : public IDRAM, public Implementation {
       "nFAW",
       "nRFC","nREFI",
       "nCS",
+      "nXP", "nPD", "nXS", "nSR",
       "tCK_ps"
     };
 
@@ -141,8 +150,8 @@ class DDR4 : public IDRAM, public Implementation {
     };
     
     inline static constexpr ImplDef m_currents = {
-      "IDD0", "IDD2N", "IDD3N", "IDD4R", "IDD4W", "IDD5B",
-      "IPP0", "IPP2N", "IPP3N", "IPP4R", "IPP4W", "IPP5B"
+      "IDD0", "IDD2N", "IDD3N", "IDD4R", "IDD4W", "IDD5B", "IDD2P", "IDD3P", "IDD6N",
+      "IPP0", "IPP2N", "IPP3N", "IPP4R", "IPP4W", "IPP5B", "IPP2P", "IPP3P", "IPP6N"
     };
 
     inline static constexpr ImplDef m_cmds_counted = {
@@ -153,7 +162,7 @@ class DDR4 : public IDRAM, public Implementation {
    *                 Node States
    ***********************************************/
     inline static constexpr ImplDef m_states = {
-       "Opened", "Closed", "PowerUp", "N/A", "Refreshing"
+       "Opened", "Closed", "PowerUp", "N/A", "Refreshing", "PowerDown", "SelfRefresh"
     };
 
     inline static const ImplLUT m_init_states = LUT (
@@ -410,6 +419,12 @@ class DDR4 : public IDRAM, public Implementation {
       m_timing_vals("nRFC")  = JEDEC_rounding(tRFC_TABLE[0][density_id], tCK_ps);
       m_timing_vals("nREFI") = JEDEC_rounding(tREFI_BASE, tCK_ps);
 
+      // Power-down and self-refresh timings (JESD79-4C, Table 169-170)
+      m_timing_vals("nXP") = std::max<int>(4, JEDEC_rounding(6, tCK_ps));
+      m_timing_vals("nPD") = std::max<int>(3, JEDEC_rounding(5, tCK_ps));
+      m_timing_vals("nXS") = JEDEC_rounding(tRFC_TABLE[0][density_id] + 10, tCK_ps);
+      m_timing_vals("nSR") = m_timing_vals("nPD") + 1;
+
       // Overwrite timing parameters with any user-provided value
       // Rate and tCK should not be overwritten
       for (int i = 1; i < m_timings.size() - 1; i++) {
@@ -436,6 +451,7 @@ class DDR4 : public IDRAM, public Implementation {
 
       // Populate the timing constraints
       #define V(timing) (m_timing_vals(timing))
+      auto all_commands = std::vector<std::string_view>(m_commands.begin(), m_commands.end());
       populate_timingcons(this, {
           /*** Channel ***/ 
           // CAS <-> CAS
@@ -469,6 +485,20 @@ class DDR4 : public IDRAM, public Implementation {
           {.level = "rank", .preceding = {"RDA"}, .following = {"REFab"}, .latency = V("nRP") + V("nRTP")},          
           {.level = "rank", .preceding = {"WRA"}, .following = {"REFab"}, .latency = V("nCWL") + V("nBL") + V("nWR") + V("nRP")},          
           {.level = "rank", .preceding = {"REFab"}, .following = {"ACT", "PREA"}, .latency = V("nRFC")},          
+          /// Power-down entry and exit
+          {.level = "rank", .preceding = {"ACT", "PRE", "PREA"}, .following = {"PDE"}, .latency = 1},
+          {.level = "rank", .preceding = {"RD", "RDA"}, .following = {"PDE"}, .latency = V("nCL") + V("nBL") + 1},
+          {.level = "rank", .preceding = {"WR"}, .following = {"PDE"}, .latency = V("nCWL") + V("nBL") + V("nWR")},
+          {.level = "rank", .preceding = {"WRA"}, .following = {"PDE"}, .latency = V("nCWL") + V("nBL") + V("nWR") + 1},
+          {.level = "rank", .preceding = {"REFab"}, .following = {"PDE", "SRE"}, .latency = V("nRFC")},
+          {.level = "rank", .preceding = {"PDE"}, .following = {"PDX"}, .latency = V("nPD")},
+          {.level = "rank", .preceding = {"PDX"}, .following = all_commands, .latency = V("nXP")},
+          /// Self-refresh entry and exit
+          {.level = "rank", .preceding = {"PRE", "PREA"}, .following = {"SRE"}, .latency = V("nRP")},
+          {.level = "rank", .preceding = {"RDA"}, .following = {"SRE"}, .latency = V("nRTP") + V("nRP")},
+          {.level = "rank", .preceding = {"WRA"}, .following = {"SRE"}, .latency = V("nCWL") + V("nBL") + V("nWR") + V("nRP")},
+          {.level = "rank", .preceding = {"SRE"}, .following = {"SRX"}, .latency = V("nSR")},
+          {.level = "rank", .preceding = {"SRX"}, .following = all_commands, .latency = V("nXS")},
 
           /*** Same Bank Group ***/ 
           /// CAS <-> CAS
@@ -500,6 +530,10 @@ class DDR4 : public IDRAM, public Implementation {
       m_actions[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Action::Rank::PREab<DDR4>;
       m_actions[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Action::Rank::REFab<DDR4>;
       m_actions[m_levels["rank"]][m_commands["REFab_end"]] = Lambdas::Action::Rank::REFab_end<DDR4>;
+      m_actions[m_levels["rank"]][m_commands["PDE"]] = Lambdas::Action::Rank::PDE<DDR4>;
+      m_actions[m_levels["rank"]][m_commands["PDX"]] = Lambdas::Action::Rank::PDX<DDR4>;
+      m_actions[m_levels["rank"]][m_commands["SRE"]] = Lambdas::Action::Rank::SRE<DDR4>;
+      m_actions[m_levels["rank"]][m_commands["SRX"]] = Lambdas::Action::Rank::SRX<DDR4>;
 
       // Bank actions
       m_actions[m_levels["bank"]][m_commands["ACT"]] = Lambdas::Action::Bank::ACT<DDR4>;
@@ -512,7 +546,16 @@ class DDR4 : public IDRAM, public Implementation {
       m_preqs.resize(m_levels.size(), std::vector<PreqFunc_t<Node>>(m_commands.size()));
 
       // Rank Actions
-      m_preqs[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Preq::Rank::RequireAllBanksClosed<DDR4>;
+      m_preqs[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Preq::Rank::RequirePoweredUpAllBanksClosed<DDR4>;
+      m_preqs[m_levels["rank"]][m_commands["SRE"]]   = Lambdas::Preq::Rank::RequirePoweredUpAllBanksClosed<DDR4>;
+      m_preqs[m_levels["rank"]][m_commands["PDE"]]   = Lambdas::Preq::Rank::RequirePoweredUp<DDR4>;
+      m_preqs[m_levels["rank"]][m_commands["RD"]]    = Lambdas::Preq::Rank::RequirePoweredUp<DDR4>;
+      m_preqs[m_levels["rank"]][m_commands["WR"]]    = Lambdas::Preq::Rank::RequirePoweredUp<DDR4>;
+      m_preqs[m_levels["rank"]][m_commands["ACT"]]   = Lambdas::Preq::Rank::RequirePoweredUp<DDR4>;
+      m_preqs[m_levels["rank"]][m_commands["PRE"]]   = Lambdas::Preq::Rank::RequirePoweredUp<DDR4>;
+      m_preqs[m_levels["rank"]][m_commands["PREA"]]  = Lambdas::Preq::Rank::RequirePoweredUp<DDR4>;
+      m_preqs[m_levels["rank"]][m_commands["RDA"]]   = Lambdas::Preq::Rank::RequirePoweredUp<DDR4>;
+      m_preqs[m_levels["rank"]][m_commands["WRA"]]   = Lambdas::Preq::Rank::RequirePoweredUp<DDR4>;
 
       // Bank actions
       m_preqs[m_levels["bank"]][m_commands["RD"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR4>;
@@ -588,20 +631,29 @@ class DDR4 : public IDRAM, public Implementation {
       m_powers[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Power::Rank::PREA<DDR4>;
       m_powers[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Power::Rank::REFab<DDR4>;
       m_powers[m_levels["rank"]][m_commands["REFab_end"]] = Lambdas::Power::Rank::REFab_end<DDR4>;
+      m_powers[m_levels["rank"]][m_commands["PDE"]] = Lambdas::Power::Rank::PDE<DDR4>;
+      m_powers[m_levels["rank"]][m_commands["PDX"]] = Lambdas::Power::Rank::PDX<DDR4>;
+      m_powers[m_levels["rank"]][m_commands["SRE"]] = Lambdas::Power::Rank::SRE<DDR4>;
+      m_powers[m_levels["rank"]][m_commands["SRX"]] = Lambdas::Power::Rank::SRX<DDR4>;
 
       // register stats
-      register_stat(s_total_background_energy).name("total_background_energy");
-      register_stat(s_total_cmd_energy).name("total_cmd_energy");
-      register_stat(s_total_energy).name("total_energy");
+      register_stat(s_total_background_energy).name("total_background_energy").computed_at_finalize();
+      register_stat(s_total_cmd_energy).name("total_cmd_energy").computed_at_finalize();
+      register_stat(s_total_energy).name("total_energy").computed_at_finalize();
             
       for (auto& power_stat : m_power_stats){
-        register_stat(power_stat.total_background_energy).name("total_background_energy_rank{}", power_stat.rank_id);
-        register_stat(power_stat.total_cmd_energy).name("total_cmd_energy_rank{}", power_stat.rank_id);
-        register_stat(power_stat.total_energy).name("total_energy_rank{}", power_stat.rank_id);
-        register_stat(power_stat.act_background_energy).name("act_background_energy_rank{}", power_stat.rank_id);
-        register_stat(power_stat.pre_background_energy).name("pre_background_energy_rank{}", power_stat.rank_id);
+        register_stat(power_stat.total_background_energy).name("total_background_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.total_cmd_energy).name("total_cmd_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.total_energy).name("total_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.act_background_energy).name("act_background_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.pre_background_energy).name("pre_background_energy_rank{}", power_stat.rank_id).computed_at_finalize();
         register_stat(power_stat.active_cycles).name("active_cycles_rank{}", power_stat.rank_id);
         register_stat(power_stat.idle_cycles).name("idle_cycles_rank{}", power_stat.rank_id);
+        register_stat(power_stat.pd_background_energy).name("pd_background_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.sr_background_energy).name("sr_background_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.act_pd_cycles).name("act_pd_cycles_rank{}", power_stat.rank_id);
+        register_stat(power_stat.pre_pd_cycles).name("pre_pd_cycles_rank{}", power_stat.rank_id);
+        register_stat(power_stat.sr_cycles).name("sr_cycles_rank{}", power_stat.rank_id);
       }
     }
 
@@ -611,6 +663,10 @@ class DDR4 : public IDRAM, public Implementation {
         Node* channel = new Node(this, nullptr, 0, i);
         m_channels.push_back(channel);
       }
+
+      if (m_drampower_enable) {
+        Lambdas::Power::Rank::init_trackers<DDR4>(this, m_channels);
+      }
     }
 
     void finalize() override {
@@ -642,6 +698,12 @@ class DDR4 : public IDRAM, public Implementation {
       rank_stats.pre_background_energy = (VE("VDD") * CE("IDD2N") + VE("VPP") * CE("IPP2N")) 
                                             * rank_stats.idle_cycles * tCK_ns / 1E3;
 
+      rank_stats.pd_background_energy = ((VE("VDD") * CE("IDD2P") + VE("VPP") * CE("IPP2P")) * rank_stats.pre_pd_cycles
+                                          + (VE("VDD") * CE("IDD3P") + VE("VPP") * CE("IPP3P")) * rank_stats.act_pd_cycles)
+                                            * tCK_ns / 1E3;
+
+      rank_stats.sr_background_energy = (VE("VDD") * CE("IDD6N") + VE("VPP") * CE("IPP6N")) 
+                                            * rank_stats.sr_cycles * tCK_ns / 1E3;
 
       double act_cmd_energy  = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0") - CE("IPP3N"))) 
                                       * rank_stats.cmd_counters[m_cmds_counted("ACT")] * TS("nRAS") * tCK_ns / 1E3;
@@ -658,7 +720,8 @@ class DDR4 : public IDRAM, public Implementation {
       double ref_cmd_energy  = (VE("VDD") * (CE("IDD5B")) + VE("VPP") * (CE("IPP5B"))) 
                                       * rank_stats.cmd_counters[m_cmds_counted("REF")] * TS("nRFC") * tCK_ns / 1E3;
 
-      rank_stats.total_background_energy = rank_stats.act_background_energy + rank_stats.pre_background_energy;
+      rank_stats.total_background_energy = rank_stats.act_background_energy + rank_stats.pre_background_energy
+                                           + rank_stats.pd_background_energy + rank_stats.sr_background_energy;
       rank_stats.total_cmd_energy = act_cmd_energy 
                                     + pre_cmd_energy 
                                     + rd_cmd_energy
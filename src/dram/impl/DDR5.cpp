@@ -27,10 +27,10 @@ class DDR5 : public IDRAM, public Implementation {
     };
 
     inline static const std::map<std::string, std::vector<int>> timing_presets = {
-      //   name         rate   nBL  nCL nRCD   nRP  nRAS   nRC   nWR  nRTP nCWL nPPD nCCDS nCCDS_WR nCCDS_WTR nCCDL nCCDL_WR nCCDL_WTR nRRDS nRRDL nFAW nRFC1 nRFC2 nRFCsb nREFI nREFSBRD nRFM1 nRFM2 nRFMsb nDRFMab nDRFMsb nCS, tCK_ps
-      {"DDR5_3200AN",  {3200,   8,  24,  24,   24,   52,   75,   48,   12,  22,  2,    8,     8,     22+8+4,    8,     16,    22+8+16,   8,   -1,   -1,  -1,   -1,   -1,    -1,     30,    -1,   -1,   -1,     -1,     -1,    2,   625}},
-      {"DDR5_3200BN",  {3200,   8,  26,  26,   26,   52,   77,   48,   12,  24,  2,    8,     8,     24+8+4,    8,     16,    24+8+16,   8,   -1,   -1,  -1,   -1,   -1,    -1,     30,    -1,   -1,   -1,     -1,     -1,    2,   625}},
-      {"DDR5_3200C",   {3200,   8,  28,  28,   28,   52,   79,   48,   12,  26,  2,    8,     8,     26+8+4,    8,     16,    26+8+16,   8,   -1,   -1,  -1,   -1,   -1,    -1,     30,    -1,   -1,   -1,     -1,     -1,    2,   625}},
+      //   name         rate   nBL  nCL nRCD   nRP  nRAS   nRC   nWR  nRTP nCWL nPPD nCCDS nCCDS_WR nCCDS_WTR nCCDL nCCDL_WR nCCDL_WTR nRRDS nRRDL nFAW nRFC1 nRFC2 nRFCsb nREFI nREFSBRD nRFM1 nRFM2 nRFMsb nDRFMab nDRFMsb nCS,  nXP  nPD  nXS  nSR  tCK_ps
+      {"DDR5_3200AN",  {3200,   8,  24,  24,   24,   52,   75,   48,   12,  22,  2,    8,     8,     22+8+4,    8,     16,    22+8+16,   8,   -1,   -1,  -1,   -1,   -1,    -1,     30,    -1,   -1,   -1,     -1,     -1,    2,   -1,   -1,   -1,   -1,   625}},
+      {"DDR5_3200BN",  {3200,   8,  26,  26,   26,   52,   77,   48,   12,  24,  2,    8,     8,     24+8+4,    8,     16,    24+8+16,   8,   -1,   -1,  -1,   -1,   -1,    -1,     30,    -1,   -1,   -1,     -1,     -1,    2,   -1,   -1,   -1,   -1,   625}},
+      {"DDR5_3200C",   {3200,   8,  28,  28,   28,   52,   79,   48,   12,  26,  2,    8,     8,     26+8+4,    8,     16,    26+8+16,   8,   -1,   -1,  -1,   -1,   -1,    -1,     30,    -1,   -1,   -1,     -1,     -1,    2,   -1,   -1,   -1,   -1,   625}},
     };
 
     inline static const std::map<std::string, std::vector<double>> voltage_presets = {
@@ -39,8 +39,8 @@ class DDR5 : public IDRAM, public Implementation {
     };
 
     inline static const std::map<std::string, std::vector<double>> current_presets = {
-      // name           IDD0  IDD2N   IDD3N   IDD4R   IDD4W   IDD5B   IPP0  IPP2N  IPP3N  IPP4R  IPP4W  IPP5B
-      {"Default",       {60,   50,     55,     145,    145,    362,     3,    3,     3,     3,     3,     48}},
+      // name           IDD0  IDD2N   IDD3N   IDD4R   IDD4W   IDD5B   IDD2P   IDD3P   IDD6N   IPP0  IPP2N  IPP3N  IPP4R  IPP4W  IPP5B  IPP2P  IPP3P  IPP6N
+      {"Default",       {60,   50,     55,     145,    145,    362,    38,     48,     36,      3,    3,     3,     3,     3,     48,    3,     3,     4}},
     };
   /************************************************
    *                Organization
@@ -62,6 +62,7 @@ class DDR5 : public IDRAM, public Implementation {
       "REFab",  "REFsb", "REFab_end", "REFsb_end",
       "RFMab",  "RFMsb", "RFMab_end", "RFMsb_end",
       "DRFMab", "DRFMsb", "DRFMab_end", "DRFMsb_end",
+      "PDE", "PDX", "SRE", "SRX",
     };
 
     inline static const ImplLUT m_command_scopes = LUT (
@@ -72,6 +73,7 @@ class DDR5 : public IDRAM, public Implementation {
         {"REFab",  "rank"},  {"REFsb",  "bank"}, {"REFab_end",  "rank"},  {"REFsb_end",  "bank"},
         {"RFMab",  "rank"},  {"RFMsb",  "bank"}, {"RFMab_end",  "rank"},  {"RFMsb_end",  "bank"},
         {"DRFMab", "rank"},  {"DRFMsb", "bank"}, {"DRFMab_end", "rank"},  {"DRFMsb_end", "bank"},
+        {"PDE",    "rank"},  {"PDX",    "rank"}, {"SRE",        "rank"},  {"SRX",        "rank"},
       }
     );
 
@@ -98,6 +100,10 @@ class DDR5 : public IDRAM, public Implementation {
         {"DRFMsb",      {false,  false,   false,   true }},
         {"DRFMab_end",  {false,  true,    false,   false}},
         {"DRFMsb_end",  {false,  true,    false,   false}},
+        {"PDE",         {false,  false,   false,   false}},
+        {"PDX",         {false,  false,   false,   false}},
+        {"SRE",         {false,  false,   false,   false}},
+        {"SRX",         {false,  false,   false,   false}},
       }
     );
 
@@ -106,7 +112,8 @@ class DDR5 : public IDRAM, public Implementation {
       "all-bank-refresh", "same-bank-refresh", 
       "rfm", "same-bank-rfm",
       "directed-rfm", "same-bank-directed-rfm",
-      "open-row", "close-row"
+      "open-row", "close-row",
+      "power-down", "self-refresh"
     };
 
     inline static const ImplLUT m_request_translations = LUT (
@@ -115,7 +122,8 @@ class DDR5 : public IDRAM, public Implementation {
         {"all-bank-refresh", "REFab"}, {"same-bank-refresh", "REFsb"}, 
         {"rfm", "RFMab"}, {"same-bank-rfm", "RFMsb"}, 
         {"directed-rfm", "DRFMab"}, {"same-bank-directed-rfm", "DRFMsb"}, 
-        {"open-row", "ACT"}, {"close-row", "PRE"}
+        {"open-row", "ACT"}, {"close-row", "PRE"},
+        {"power-down", "PDE"}, {"self-refresh", "SRE"}
       }
     );
 
@@ -134,6 +142,7 @@ class DDR5 : public IDRAM, public Implementation {
       "nRFM1", "nRFM2", "nRFMsb", 
       "nDRFMab", "nDRFMsb", 
       "nCS",
+      "nXP", "nPD", "nXS", "nSR",
       "tCK_ps"
     };
    
@@ -145,8 +154,8 @@ class DDR5 : public IDRAM, public Implementation {
     };
     
     inline static constexpr ImplDef m_currents = {
-      "IDD0", "IDD2N", "IDD3N", "IDD4R", "IDD4W", "IDD5B",
-      "IPP0", "IPP2N", "IPP3N", "IPP4R", "IPP4W", "IPP5B"
+      "IDD0", "IDD2N", "IDD3N", "IDD4R", "IDD4W", "IDD5B", "IDD2P", "IDD3P", "IDD6N",
+      "IPP0", "IPP2N", "IPP3N", "IPP4R", "IPP4W", "IPP5B", "IPP2P", "IPP3P", "IPP6N"
     };
 
     inline static constexpr ImplDef m_cmds_counted = {
@@ -157,7 +166,7 @@ class DDR5 : public IDRAM, public Implementation {
    *                 Node States
    ***********************************************/
     inline static constexpr ImplDef m_states = {
-       "Opened", "Closed", "PowerUp", "N/A", "Refreshing"
+       "Opened", "Closed", "PowerUp", "N/A", "Refreshing", "PowerDown", "SelfRefresh"
     };
 
     inline static const ImplLUT m_init_states = LUT (
@@ -482,6 +491,12 @@ class DDR5 : public IDRAM, public Implementation {
       m_timing_vals("nDRFMab") = 2 * m_BRC * JEDEC_rounding_DDR5(tRRFsb_TABLE[0][density_id], tCK_ps);
       m_timing_vals("nDRFMsb") = 2 * m_BRC * JEDEC_rounding_DDR5(tRRFsb_TABLE[1][density_id], tCK_ps);
 
+      // Power-down and self-refresh timings (JESD79-5, tXP/tPD = max(7.5ns, 8nCK), tCSH_SRexit = 15ns)
+      m_timing_vals("nXP") = std::max<int>(8, JEDEC_rounding_DDR5(7.5, tCK_ps));
+      m_timing_vals("nPD") = m_timing_vals("nXP");
+      m_timing_vals("nXS") = m_timing_vals("nRFC1");
+      m_timing_vals("nSR") = std::max<int>(3, JEDEC_rounding_DDR5(15, tCK_ps));
+
 
       // Overwrite timing parameters with any user-provided value
       // Rate and tCK should not be overwritten
@@ -552,6 +567,25 @@ class DDR5 : public IDRAM, public Implementation {
           {.level = "rank", .preceding = {"REFsb"},  .following = {"PREA", "REFab", "RFMab", "DRFMab"}, .latency = V("nRFCsb")},  
           {.level = "rank", .preceding = {"RFMsb"},  .following = {"PREA", "REFab", "RFMab", "DRFMab"}, .latency = V("nRFMsb")},  
           {.level = "rank", .preceding = {"DRFMsb"}, .following = {"PREA", "REFab", "RFMab", "DRFMab"}, .latency = V("nDRFMsb")},  
+          /// Power-down entry and exit
+          {.level = "rank", .preceding = {"ACT", "PRE", "PREA", "PREsb"}, .following = {"PDE"}, .latency = 1},
+          {.level = "rank", .preceding = {"RD", "RDA"}, .following = {"PDE"}, .latency = V("nCL") + V("nBL") + 1},
+          {.level = "rank", .preceding = {"WR"}, .following = {"PDE"}, .latency = V("nCWL") + V("nBL") + V("nWR")},
+          {.level = "rank", .preceding = {"WRA"}, .following = {"PDE"}, .latency = V("nCWL") + V("nBL") + V("nWR") + 1},
+          {.level = "rank", .preceding = {"REFab"},  .following = {"PDE", "SRE"}, .latency = V("nRFC1")},
+          {.level = "rank", .preceding = {"RFMab"},  .following = {"PDE", "SRE"}, .latency = V("nRFM1")},
+          {.level = "rank", .preceding = {"DRFMab"}, .following = {"PDE", "SRE"}, .latency = V("nDRFMab")},
+          {.level = "rank", .preceding = {"REFsb"},  .following = {"PDE", "SRE"}, .latency = V("nRFCsb")},
+          {.level = "rank", .preceding = {"RFMsb"},  .following = {"PDE", "SRE"}, .latency = V("nRFMsb")},
+          {.level = "rank", .preceding = {"DRFMsb"}, .following = {"PDE", "SRE"}, .latency = V("nDRFMsb")},
+          {.level = "rank", .preceding = {"PDE"}, .following = {"PDX"}, .latency = V("nPD")},
+          {.level = "rank", .preceding = {"PDX"}, .following = all_commands, .latency = V("nXP")},
+          /// Self-refresh entry and exit
+          {.level = "rank", .preceding = {"PRE", "PREA", "PREsb"}, .following = {"SRE"}, .latency = V("nRP")},
+          {.level = "rank", .preceding = {"RDA"}, .following = {"SRE"}, .latency = V("nRTP") + V("nRP")},
+          {.level = "rank", .preceding = {"WRA"}, .following = {"SRE"}, .latency = V("nCWL") + V("nBL") + V("nWR") + V("nRP")},
+          {.level = "rank", .preceding = {"SRE"}, .following = {"SRX"}, .latency = V("nSR")},
+          {.level = "rank", .preceding = {"SRX"}, .following = all_commands, .latency = V("nXS")},
           /*** Same Bank Group ***/ 
           /// CAS <-> CAS
           {.level = "bankgroup", .preceding = {"RD", "RDA"}, .following = {"RD", "RDA"}, .latency = V("nCCDL")},          
@@ -592,6 +626,10 @@ class DDR5 : public IDRAM, public Implementation {
       m_actions[m_levels["rank"]][m_commands["RFMab_end"]] = Lambdas::Action::Rank::REFab_end<DDR5>;
       m_actions[m_levels["rank"]][m_commands["DRFMab"]] = Lambdas::Action::Rank::REFab<DDR5>;
       m_actions[m_levels["rank"]][m_commands["DRFMab_end"]] = Lambdas::Action::Rank::REFab_end<DDR5>;
+      m_actions[m_levels["rank"]][m_commands["PDE"]] = Lambdas::Action::Rank::PDE<DDR5>;
+      m_actions[m_levels["rank"]][m_commands["PDX"]] = Lambdas::Action::Rank::PDX<DDR5>;
+      m_actions[m_levels["rank"]][m_commands["SRE"]] = Lambdas::Action::Rank::SRE<DDR5>;
+      m_actions[m_levels["rank"]][m_commands["SRX"]] = Lambdas::Action::Rank::SRX<DDR5>;
       
       // Same-Bank Actions.
       m_actions[m_levels["bankgroup"]][m_commands["PREsb"]] = Lambdas::Action::BankGroup::PREsb<DDR5>;
@@ -615,14 +653,28 @@ class DDR5 : public IDRAM, public Implementation {
       m_preqs.resize(m_levels.size(), std::vector<PreqFunc_t<Node>>(m_commands.size()));
 
       // Rank Preqs
-      m_preqs[m_levels["rank"]][m_commands["REFab"]]  = Lambdas::Preq::Rank::RequireAllBanksClosed<DDR5>;
-      m_preqs[m_levels["rank"]][m_commands["RFMab"]]  = Lambdas::Preq::Rank::RequireAllBanksClosed<DDR5>;
-      m_preqs[m_levels["rank"]][m_commands["DRFMab"]] = Lambdas::Preq::Rank::RequireAllBanksClosed<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["REFab"]]  = Lambdas::Preq::Rank::RequirePoweredUpAllBanksClosed<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["RFMab"]]  = Lambdas::Preq::Rank::RequirePoweredUpAllBanksClosed<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["DRFMab"]] = Lambdas::Preq::Rank::RequirePoweredUpAllBanksClosed<DDR5>;
 
       // Same-Bank Preqs.
-      m_preqs[m_levels["rank"]][m_commands["REFsb"]]  = Lambdas::Preq::Rank::RequireSameBanksClosed<DDR5>;
-      m_preqs[m_levels["rank"]][m_commands["RFMsb"]]  = Lambdas::Preq::Rank::RequireSameBanksClosed<DDR5>;
-      m_preqs[m_levels["rank"]][m_commands["DRFMsb"]] = Lambdas::Preq::Rank::RequireSameBanksClosed<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["REFsb"]]  = Lambdas::Preq::Rank::RequirePoweredUpSameBanksClosed<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["RFMsb"]]  = Lambdas::Preq::Rank::RequirePoweredUpSameBanksClosed<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["DRFMsb"]] = Lambdas::Preq::Rank::RequirePoweredUpSameBanksClosed<DDR5>;
+
+      // Power-down and self-refresh Preqs
+      m_preqs[m_levels["rank"]][m_commands["SRE"]] = Lambdas::Preq::Rank::RequirePoweredUpAllBanksClosed<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["PDE"]] = Lambdas::Preq::Rank::RequirePoweredUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["RD"]]  = Lambdas::Preq::Rank::RequirePoweredUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["WR"]]  = Lambdas::Preq::Rank::RequirePoweredUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["ACT"]] = Lambdas::Preq::Rank::RequirePoweredUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["PRE"]] = Lambdas::Preq::Rank::RequirePoweredUp<DDR5>;
+
+      // Precharge-all, same-bank precharge, and auto-precharge Preqs
+      m_preqs[m_levels["rank"]][m_commands["PREA"]]  = Lambdas::Preq::Rank::RequirePoweredUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["PREsb"]] = Lambdas::Preq::Rank::RequirePoweredUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["RDA"]]   = Lambdas::Preq::Rank::RequirePoweredUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["WRA"]]   = Lambdas::Preq::Rank::RequirePoweredUp<DDR5>;
 
       // Bank Preqs
       m_preqs[m_levels["bank"]][m_commands["RD"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR5>;
@@ -712,21 +764,31 @@ class DDR5 : public IDRAM, public Implementation {
 
       m_powers[m_levels["rank"]][m_commands["PREsb"]] = Lambdas::Power::Rank::PREsb<DDR5>;
 
+      m_powers[m_levels["rank"]][m_commands["PDE"]] = Lambdas::Power::Rank::PDE<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["PDX"]] = Lambdas::Power::Rank::PDX<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["SRE"]] = Lambdas::Power::Rank::SRE<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["SRX"]] = Lambdas::Power::Rank::SRX<DDR5>;
+
       // register stats
-      register_stat(s_total_background_energy).name("total_background_energy");
-      register_stat(s_total_cmd_energy).name("total_cmd_energy");
-      register_stat(s_total_energy).name("total_energy");
-      register_stat(s_total_rfm_energy).name("total_rfm_energy");
+      register_stat(s_total_background_energy).name("total_background_energy").computed_at_finalize();
+      register_stat(s_total_cmd_energy).name("total_cmd_energy").computed_at_finalize();
+      register_stat(s_total_energy).name("total_energy").computed_at_finalize();
+      register_stat(s_total_rfm_energy).name("total_rfm_energy").computed_at_finalize();
 
             
       for (auto& power_stat : m_power_stats){
-        register_stat(power_stat.total_background_energy).name("total_background_energy_rank{}", power_stat.rank_id);
-        register_stat(power_stat.total_cmd_energy).name("total_cmd_energy_rank{}", power_stat.rank_id);
-        register_stat(power_stat.total_energy).name("total_energy_rank{}", power_stat.rank_id);
-        register_stat(power_stat.act_background_energy).name("act_background_energy_rank{}", power_stat.rank_id);
-        register_stat(power_stat.pre_background_energy).name("pre_background_energy_rank{}", power_stat.rank_id);
+        register_stat(power_stat.total_background_energy).name("total_background_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.total_cmd_energy).name("total_cmd_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.total_energy).name("total_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.act_background_energy).name("act_background_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.pre_background_energy).name("pre_background_energy_rank{}", power_stat.rank_id).computed_at_finalize();
         register_stat(power_stat.active_cycles).name("active_cycles_rank{}", power_stat.rank_id);
         register_stat(power_stat.idle_cycles).name("idle_cycles_rank{}", power_stat.rank_id);
+        register_stat(power_stat.pd_background_energy).name("pd_background_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.sr_background_energy).name("sr_background_energy_rank{}", power_stat.rank_id).computed_at_finalize();
+        register_stat(power_stat.act_pd_cycles).name("act_pd_cycles_rank{}", power_stat.rank_id);
+        register_stat(power_stat.pre_pd_cycles).name("pre_pd_cycles_rank{}", power_stat.rank_id);
+        register_stat(power_stat.sr_cycles).name("sr_cycles_rank{}", power_stat.rank_id);
       }
     }
 
@@ -736,6 +798,10 @@ class DDR5 : public IDRAM, public Implementation {
         Node* channel = new Node(this, nullptr, 0, i);
         m_channels.push_back(channel);
       }
+
+      if (m_drampower_enable) {
+        Lambdas::Power::Rank::init_trackers<DDR5>(this, m_channels);
+      }
     }
     
     void finalize() override {
@@ -769,6 +835,12 @@ class DDR5 : public IDRAM, public Implementation {
       rank_stats.pre_background_energy = (VE("VDD") * CE("IDD2N") + VE("VPP") * CE("IPP2N")) 
                                             * rank_stats.idle_cycles * tCK_ns / 1E3;
 
+      rank_stats.pd_background_energy = ((VE("VDD") * CE("IDD2P") + VE("VPP") * CE("IPP2P")) * rank_stats.pre_pd_cycles
+                                          + (VE("VDD") * CE("IDD3P") + VE("VPP") * CE("IPP3P")) * rank_stats.act_pd_cycles)
+                                            * tCK_ns / 1E3;
+
+      rank_stats.sr_background_energy = (VE("VDD") * CE("IDD6N") + VE("VPP") * CE("IPP6N")) 
+                                            * rank_stats.sr_cycles * tCK_ns / 1E3;
 
       double act_cmd_energy  = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0") - CE("IPP3N"))) 
                                       * rank_stats.cmd_counters[m_cmds_counted("ACT")] * TS("nRAS") * tCK_ns / 1E3;
@@ -788,7 +860,8 @@ class DDR5 : public IDRAM, public Implementation {
       double rfm_cmd_energy = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0") - CE("IPP3N"))) * num_bankgroups
                                       * rank_stats.cmd_counters[m_cmds_counted("RFM")] * TS("nRFMsb") * tCK_ns / 1E3;
 
-      rank_stats.total_background_energy = rank_stats.act_background_energy + rank_stats.pre_background_energy;
+      rank_stats.total_background_energy = rank_stats.act_background_energy + rank_stats.pre_background_energy
+                                           + rank_stats.pd_background_energy + rank_stats.sr_background_energy;
       rank_stats.total_cmd_energy = act_cmd_energy 
                                     + pre_cmd_energy 
                                     + rd_cmd_energy
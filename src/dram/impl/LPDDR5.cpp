@@ -418,7 +418,7 @@ class LPDDR5 : public IDRAM, public Implementation {
       };
       // Bank actions
       m_actions[m_levels["bank"]][m_commands["ACT-1"]] = [] (Node* node, int cmd, int target_id, Clk_t clk) {
-        node->m_state = m_states["Pre-Opened"];
+        node->set_state(m_states["Pre-Opened"]);
         node->m_row_state[target_id] = m_states["Pre-Opened"];
       };
       m_actions[m_levels["bank"]][m_commands["ACT-2"]] = Lambdas::Action::Bank::ACT<LPDDR5>;
@@ -15,24 +15,24 @@ namespace Action {
 namespace Bank {
   template <class T>
   void ACT(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
-    node->m_state = T::m_states["Opened"];
+    node->set_state(T::m_states["Opened"]);
     node->m_row_state[target_id] = T::m_states["Opened"];
   };
 
   template <class T>
   void PRE(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
-    node->m_state = T::m_states["Closed"];
+    node->set_state(T::m_states["Closed"]);
     node->m_row_state.clear();
   };
 
   template <class T>
   void VRR(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
-    node->m_state = T::m_states["Refreshing"];
+    node->set_state(T::m_states["Refreshing"]);
   };
 
   template <class T>
   void VRR_end(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
-    node->m_state = T::m_states["Closed"];
+    node->set_state(T::m_states["Closed"]);
   };
 
 }       // namespace Bank
@@ -42,7 +42,7 @@ template <class T>
   void PREsb(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
     for (auto bank : node->m_child_nodes) {
       if (bank->m_node_id == target_id) {
-        bank->m_state = T::m_states["Closed"];
+        bank->set_state(T::m_states["Closed"]);
         bank->m_row_state.clear();
       }
     }
@@ -53,7 +53,7 @@ template <class T>
   void REFsb(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
     for (auto bank : node->m_child_nodes) {
       if (bank->m_node_id == target_id) {
-        bank->m_state = T::m_states["Refreshing"];
+        bank->set_state(T::m_states["Refreshing"]);
       }
     }
   }
@@ -62,7 +62,7 @@ template <class T>
   void REFsb_end(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
     for (auto bank : node->m_child_nodes) {
       if (bank->m_node_id == target_id) {
-        bank->m_state = T::m_states["Closed"];
+        bank->set_state(T::m_states["Closed"]);
         bank->m_row_state.clear();
       }
     }
@@ -74,13 +74,13 @@ namespace Rank {
   void PREab(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
     if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 1) {
       for (auto bank : node->m_child_nodes) {
-        bank->m_state = T::m_states["Closed"];
+        bank->set_state(T::m_states["Closed"]);
         bank->m_row_state.clear();
       }
     } else if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 2) {
       for (auto bg : node->m_child_nodes) {
         for (auto bank : bg->m_child_nodes) {
-          bank->m_state = T::m_states["Closed"];
+          bank->set_state(T::m_states["Closed"]);
           bank->m_row_state.clear();
         }
       }
@@ -96,7 +96,7 @@ template <class T>
   void REFab(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
     for (auto bg : node->m_child_nodes) {
       for (auto bank : bg->m_child_nodes) {
-        bank->m_state = T::m_states["Refreshing"];
+        bank->set_state(T::m_states["Refreshing"]);
       }
     }
   };
@@ -105,11 +105,31 @@ template <class T>
   void REFab_end(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
     for (auto bg : node->m_child_nodes) {
       for (auto bank : bg->m_child_nodes) {
-        bank->m_state = T::m_states["Closed"];
+        bank->set_state(T::m_states["Closed"]);
       }
     }
   };
 
+  template <class T>
+  void PDE(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
+    node->m_state = T::m_states["PowerDown"];
+  };
+
+  template <class T>
+  void PDX(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
+    node->m_state = T::m_states["PowerUp"];
+  };
+
+  template <class T>
+  void SRE(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
+    node->m_state = T::m_states["SelfRefresh"];
+  };
+
+  template <class T>
+  void SRX(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
+    node->m_state = T::m_states["PowerUp"];
+  };
+
   }       // namespace Rank
 
 namespace Channel {
@@ -119,7 +139,7 @@ namespace Channel {
     if constexpr (T::m_levels["bank"] - T::m_levels["channel"] == 2) {
       for (auto bg : node->m_child_nodes) {
         for (auto bank : bg->m_child_nodes) {
-          bank->m_state = T::m_states["Closed"];
+          bank->set_state(T::m_states["Closed"]);
           bank->m_row_state.clear();
         }
       }
@@ -127,7 +147,7 @@ namespace Channel {
       for (auto pc : node->m_child_nodes) {
         for (auto bg : pc->m_child_nodes) {
           for (auto bank : bg->m_child_nodes) {
-            bank->m_state = T::m_states["Closed"];
+            bank->set_state(T::m_states["Closed"]);
             bank->m_row_state.clear();
           }
         }
@@ -7,67 +7,48 @@ namespace Ramulator {
 namespace Lambdas {
 namespace Power {
 namespace Bank {
-  template <class T>
-  int get_flat_rank_id(typename T::Node* node) {
-    int channel_id = -1;
-    int rank_id = -1;
-    int num_ranks = node->m_spec->get_level_size("rank");
-    if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 1) {
-      auto rank_node = node->m_parent_node;
-      auto channel_node = rank_node->m_parent_node;
-      rank_id = rank_node->m_node_id;
-      channel_id = channel_node->m_node_id;
-    } else if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 2) {
-      auto bg_node = node->m_parent_node;
-      auto rank_node = bg_node->m_parent_node;
-      auto channel_node = rank_node->m_parent_node;
-      rank_id = rank_node->m_node_id;
-      channel_id = channel_node->m_node_id;
-    }
-    return channel_id * num_ranks + rank_id;
-  }
-
-  template <class T>
-  void debug(typename T::Node* node, std::string msg, Clk_t clk) {
+  template <class T, typename... Args>
+  void debug(typename T::Node* node, Clk_t clk, fmt::format_string<Args...> format, Args&&... args) {
+    // Only format the message when it is printed
     if (node->m_spec->m_power_debug) {
-      std::cout << "[Power] Rank" << Bank::get_flat_rank_id<T>(node) << " Bank" << node->m_node_id << " " << msg << " @ " << clk << std::endl;
+      std::cout << "[Power] Rank" << node->m_flat_rank_id << " Bank" << node->m_node_id << " " << fmt::format(format, std::forward<Args>(args)...) << " @ " << clk << std::endl;
     }
   }
 
   template <class T>
   void ACT(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Bank::debug<T>(node, "Incrementing ACT counter.", clk);
-    node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)].cmd_counters[T::m_cmds_counted("ACT")]++;
+    Bank::debug<T>(node, clk, "Incrementing ACT counter.");
+    node->m_spec->m_power_stats[node->m_flat_rank_id].cmd_counters[T::m_cmds_counted("ACT")]++;
   }
 
   template <class T>
   void PRE(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Bank::debug<T>(node, "Incrementing PRE counter.", clk);
-    node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)].cmd_counters[T::m_cmds_counted("PRE")]++;
+    Bank::debug<T>(node, clk, "Incrementing PRE counter.");
+    node->m_spec->m_power_stats[node->m_flat_rank_id].cmd_counters[T::m_cmds_counted("PRE")]++;
   }
 
   template <class T>
   void RD(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Bank::debug<T>(node, "Incrementing RD counter.", clk);
-    node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)].cmd_counters[T::m_cmds_counted("RD")]++;
+    Bank::debug<T>(node, clk, "Incrementing RD counter.");
+    node->m_spec->m_power_stats[node->m_flat_rank_id].cmd_counters[T::m_cmds_counted("RD")]++;
   }
 
   template <class T>
   void WR(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Bank::debug<T>(node, "Incrementing WR counter.", clk);
-    node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)].cmd_counters[T::m_cmds_counted("WR")]++;
+    Bank::debug<T>(node, clk, "Incrementing WR counter.");
+    node->m_spec->m_power_stats[node->m_flat_rank_id].cmd_counters[T::m_cmds_counted("WR")]++;
   }
 
   template <class T>
   void VRR(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Bank::debug<T>(node, "Incrementing VRR counter.", clk);
-    node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)].cmd_counters[T::m_cmds_counted("VRR")]++;
+    Bank::debug<T>(node, clk, "Incrementing VRR counter.");
+    node->m_spec->m_power_stats[node->m_flat_rank_id].cmd_counters[T::m_cmds_counted("VRR")]++;
   }
 
   template <class T>
   void RVRR(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Bank::debug<T>(node, "Incrementing RVRR counter.", clk);
-    node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)].cmd_counters[T::m_cmds_counted("RVRR")]++;
+    Bank::debug<T>(node, clk, "Incrementing RVRR counter.");
+    node->m_spec->m_power_stats[node->m_flat_rank_id].cmd_counters[T::m_cmds_counted("RVRR")]++;
   }
 }      // namespace Bank
 
@@ -77,264 +58,295 @@ namespace Bank {
 
 
 namespace Rank {
-  template <class T>
-  int get_flat_rank_id(typename T::Node* node) {
-    int num_ranks = node->m_spec->get_level_size("rank");
-    auto channel_node = node->m_parent_node;
-    int rank_id = node->m_node_id;
-    int channel_id = channel_node->m_node_id;
-    return channel_id * num_ranks + rank_id;
-  }
-
-  template <class T>
-  void debug(typename T::Node* node, std::string msg, Clk_t clk) {
+  template <class T, typename... Args>
+  void debug(typename T::Node* node, Clk_t clk, fmt::format_string<Args...> format, Args&&... args) {
+    // Only format the message when it is printed
     if (node->m_spec->m_power_debug) {
-      std::cout << "[Power] Rank" << Rank::get_flat_rank_id<T>(node) << " " << msg << " @ " << clk << std::endl;
+      std::cout << "[Power] Rank" << node->m_flat_rank_id << " " << fmt::format(format, std::forward<Args>(args)...) << " @ " << clk << std::endl;
     }
   }
 
-  template <class T>
-  int get_open_bank_count(typename T::Node* node) {
-    int bank_count = 0;
+  template <class T, typename Func_t>
+  void for_each_bank(typename T::Node* node, Func_t&& func) {
     if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 1) {
       for (auto bank: node->m_child_nodes) {
-        if (bank->m_state == T::m_states["Opened"]) {
-          bank_count++;
-        }
+        func(bank);
       }
     } else if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 2) {
       for (auto bg : node->m_child_nodes) {
         for (auto bank: bg->m_child_nodes) {
-          if (bank->m_state == T::m_states["Opened"]) {
-              bank_count++;
-          }
+          func(bank);
         }
       }
     }
-    return bank_count;
   }
 
+  /**
+   * @brief   Precomputes the flat rank ids of the rank and bank nodes and starts tracking the bank states (call after creating the nodes).
+   */
   template <class T>
-  int get_refreshing_bank_count(typename T::Node* node) {
-    int bank_count = 0;
-    if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 1) {
-      for (auto bank: node->m_child_nodes) {
-        if (bank->m_state == T::m_states["Refreshing"]) {
-          bank_count++;
-        }
-      }
-    } else if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 2) {
-      for (auto bg : node->m_child_nodes) {
-        for (auto bank: bg->m_child_nodes) {
-          if (bank->m_state == T::m_states["Refreshing"]) {
-              bank_count++;
-          }
-        }
+  void init_trackers(T* spec, const std::vector<typename T::Node*>& channels) {
+    spec->m_power_opened_state = T::m_states["Opened"];
+    spec->m_power_refreshing_state = T::m_states["Refreshing"];
+
+    int num_ranks = spec->get_level_size("rank");
+    for (auto channel : channels) {
+      for (auto rank : channel->m_child_nodes) {
+        int flat_rank_id = channel->m_node_id * num_ranks + rank->m_node_id;
+        auto& rank_stats = spec->m_power_stats[flat_rank_id];
+        rank->m_flat_rank_id = flat_rank_id;
+        rank_stats.num_open_banks = 0;
+        rank_stats.num_refreshing_banks = 0;
+        for_each_bank<T>(rank, [&](typename T::Node* bank) {
+          bank->m_flat_rank_id = flat_rank_id;
+          rank_stats.num_open_banks += bank->m_state == spec->m_power_opened_state;
+          rank_stats.num_refreshing_banks += bank->m_state == spec->m_power_refreshing_state;
+        });
       }
     }
-    return bank_count;
   }
 
   template <class T>
   void ACT(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------ACT------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
-    bool is_rank_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 0;
+    Rank::debug<T>(node, clk, "------ACT------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
+    bool is_rank_idle = cur_power_stats.num_open_banks == 0 && cur_power_stats.num_refreshing_banks == 0;
     
     if (is_rank_idle) {
       cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
       cur_power_stats.active_start_cycle = clk;
-      std::string msg = "Rank is idle. idle_cycles: " + std::to_string(cur_power_stats.idle_cycles) + "    active_start_cycle: " + std::to_string(cur_power_stats.active_start_cycle);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is idle. idle_cycles: {}    active_start_cycle: {}", cur_power_stats.idle_cycles, cur_power_stats.active_start_cycle);
       cur_power_stats.cur_power_state = PowerStats::PowerState::ACTIVE;
     }
   }
 
   template <class T>
   void PRE(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------PRE------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
-    bool is_rank_going_idle = get_open_bank_count<T>(node) == 1 && get_refreshing_bank_count<T>(node) == 0; // TODO: AND this PRE is targetting the active bank
+    Rank::debug<T>(node, clk, "------PRE------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
+    bool is_rank_going_idle = cur_power_stats.num_open_banks == 1 && cur_power_stats.num_refreshing_banks == 0; // TODO: AND this PRE is targetting the active bank
 
     if (is_rank_going_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
       cur_power_stats.idle_start_cycle = clk;
-      std::string msg = "Rank is going idle. active_cycles: " + std::to_string(cur_power_stats.active_cycles) + "    idle_start_cycle: " + std::to_string(cur_power_stats.idle_start_cycle);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is going idle. active_cycles: {}    idle_start_cycle: {}", cur_power_stats.active_cycles, cur_power_stats.idle_start_cycle);
       cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
     }
   }
 
   template <class T>
   void PREA(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------PREA------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
-    bool is_rank_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 0;
+    Rank::debug<T>(node, clk, "------PREA------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
+    bool is_rank_idle = cur_power_stats.num_open_banks == 0 && cur_power_stats.num_refreshing_banks == 0;
 
-    assert(get_refreshing_bank_count<T>(node) == 0 && "PREA should not be called when there are refreshing banks");
+    assert(cur_power_stats.num_refreshing_banks == 0 && "PREA should not be called when there are refreshing banks");
 
-    cur_power_stats.cmd_counters[T::m_cmds_counted("PRE")] += get_open_bank_count<T>(node);
-    Rank::debug<T>(node, "Incrementing PRE counter.", clk);
+    cur_power_stats.cmd_counters[T::m_cmds_counted("PRE")] += cur_power_stats.num_open_banks;
+    Rank::debug<T>(node, clk, "Incrementing PRE counter.");
     if (!is_rank_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
       cur_power_stats.idle_start_cycle = clk;
-      std::string msg = "Rank is not idle. active_cycles: " + std::to_string(cur_power_stats.active_cycles) + "    idle_start_cycle: " + std::to_string(cur_power_stats.idle_start_cycle);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is not idle. active_cycles: {}    idle_start_cycle: {}", cur_power_stats.active_cycles, cur_power_stats.idle_start_cycle);
       cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
     }    
   }
 
   template <class T>
   void REFab(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------REFab------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------REFab------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
     cur_power_stats.cmd_counters[T::m_cmds_counted("REF")]++;
 
     // We assume rank is idle when REF is called
 
     cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
-    std::string msg = "Refresh starts. idle_cycles: " + std::to_string(cur_power_stats.idle_cycles);
-    Rank::debug<T>(node, msg, clk);
+    Rank::debug<T>(node, clk, "Refresh starts. idle_cycles: {}", cur_power_stats.idle_cycles);
     cur_power_stats.cur_power_state = PowerStats::PowerState::REFRESHING;
   }
 
   template <class T>
   void REFab_end(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------REFab_end------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------REFab_end------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
 
     cur_power_stats.idle_start_cycle = clk;
-    std::string msg = "Refresh ends. idle_start_cycle: " + std::to_string(cur_power_stats.idle_start_cycle);
-    Rank::debug<T>(node, msg, clk);
+    Rank::debug<T>(node, clk, "Refresh ends. idle_start_cycle: {}", cur_power_stats.idle_start_cycle);
     cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
   }
 
   template <class T>
   void VRR(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------VRR------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
-    bool is_rank_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 0;
+    Rank::debug<T>(node, clk, "------VRR------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
+    bool is_rank_idle = cur_power_stats.num_open_banks == 0 && cur_power_stats.num_refreshing_banks == 0;
 
     if (is_rank_idle) {
       cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
       cur_power_stats.active_start_cycle = clk;
-      std::string msg = "Rank is idle. idle_cycles: " + std::to_string(cur_power_stats.idle_cycles) + "    active_start_cycle: " + std::to_string(cur_power_stats.active_start_cycle);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is idle. idle_cycles: {}    active_start_cycle: {}", cur_power_stats.idle_cycles, cur_power_stats.active_start_cycle);
       cur_power_stats.cur_power_state = PowerStats::PowerState::ACTIVE;
     }
   }
   
   template <class T>
   void VRR_end(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------VRR_end------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
-    bool is_rank_going_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 1;
+    Rank::debug<T>(node, clk, "------VRR_end------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
+    bool is_rank_going_idle = cur_power_stats.num_open_banks == 0 && cur_power_stats.num_refreshing_banks == 1;
 
     if (is_rank_going_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
       cur_power_stats.idle_start_cycle = clk;
-      std::string msg = "Rank is going idle. idle_start_cycle: " + std::to_string(cur_power_stats.idle_start_cycle) + "    active_cycles: " + std::to_string(cur_power_stats.active_cycles);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is going idle. idle_start_cycle: {}    active_cycles: {}", cur_power_stats.idle_start_cycle, cur_power_stats.active_cycles);
       cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
     }
   }
 
   template <class T>
   void RFMsb(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------RFMsb------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
-    bool is_rank_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 0;
+    Rank::debug<T>(node, clk, "------RFMsb------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
+    bool is_rank_idle = cur_power_stats.num_open_banks == 0 && cur_power_stats.num_refreshing_banks == 0;
 
     cur_power_stats.cmd_counters[T::m_cmds_counted("RFM")]++;
     if (is_rank_idle) {
       cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
       cur_power_stats.active_start_cycle = clk;
-      std::string msg = "Rank is idle. idle_cycles: " + std::to_string(cur_power_stats.idle_cycles) + "    active_start_cycle: " + std::to_string(cur_power_stats.active_start_cycle);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is idle. idle_cycles: {}    active_start_cycle: {}", cur_power_stats.idle_cycles, cur_power_stats.active_start_cycle);
       cur_power_stats.cur_power_state = PowerStats::PowerState::ACTIVE;
     }
   }
 
   template <class T>
   void RFMsb_end(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------RFMsb_end------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------RFMsb_end------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
     size_t num_bankgroups = node->m_child_nodes.size();
-    bool is_rank_going_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == num_bankgroups;
+    bool is_rank_going_idle = cur_power_stats.num_open_banks == 0 && cur_power_stats.num_refreshing_banks == num_bankgroups;
 
     if (is_rank_going_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
       cur_power_stats.idle_start_cycle = clk;
-      std::string msg = "Rank is going idle. idle_start_cycle: " + std::to_string(cur_power_stats.idle_start_cycle) + "    active_cycles: " + std::to_string(cur_power_stats.active_cycles);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is going idle. idle_start_cycle: {}    active_cycles: {}", cur_power_stats.idle_start_cycle, cur_power_stats.active_cycles);
       cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
     }
   }
 
   template <class T>
   void RRFMsb(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------RRFMsb------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
-    bool is_rank_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 0;
+    Rank::debug<T>(node, clk, "------RRFMsb------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
+    bool is_rank_idle = cur_power_stats.num_open_banks == 0 && cur_power_stats.num_refreshing_banks == 0;
 
     cur_power_stats.cmd_counters[T::m_cmds_counted("RRFM")]++;
     if (is_rank_idle) {
       cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
       cur_power_stats.active_start_cycle = clk;
-      std::string msg = "Rank is idle. idle_cycles: " + std::to_string(cur_power_stats.idle_cycles) + "    active_start_cycle: " + std::to_string(cur_power_stats.active_start_cycle);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is idle. idle_cycles: {}    active_start_cycle: {}", cur_power_stats.idle_cycles, cur_power_stats.active_start_cycle);
       cur_power_stats.cur_power_state = PowerStats::PowerState::ACTIVE;
     }
   }
 
   template <class T>
   void RRFMsb_end(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------RRFMsb_end------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------RRFMsb_end------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
     size_t num_bankgroups = node->m_child_nodes.size();
-    bool is_rank_going_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == num_bankgroups;
+    bool is_rank_going_idle = cur_power_stats.num_open_banks == 0 && cur_power_stats.num_refreshing_banks == num_bankgroups;
 
     if (is_rank_going_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
       cur_power_stats.idle_start_cycle = clk;
-      std::string msg = "Rank is going idle. idle_start_cycle: " + std::to_string(cur_power_stats.idle_start_cycle) + "    active_cycles: " + std::to_string(cur_power_stats.active_cycles);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is going idle. idle_start_cycle: {}    active_cycles: {}", cur_power_stats.idle_start_cycle, cur_power_stats.active_cycles);
       cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
     }
   }
 
+  template <class T>
+  void PDE(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, clk, "------PDE------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
+
+    // Close the idle or active period the rank is in
+    if (cur_power_stats.cur_power_state == PowerStats::PowerState::ACTIVE) {
+      cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
+    } else if (cur_power_stats.cur_power_state == PowerStats::PowerState::IDLE) {
+      cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
+    }
+    cur_power_stats.is_act_pd = cur_power_stats.num_open_banks > 0;
+    cur_power_stats.low_power_start_cycle = clk;
+    Rank::debug<T>(node, clk, "Power-down starts. active_cycles: {}    idle_cycles: {}", cur_power_stats.active_cycles, cur_power_stats.idle_cycles);
+    cur_power_stats.cur_power_state = PowerStats::PowerState::POWER_DOWN;
+  }
+
+  template <class T>
+  void PDX(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, clk, "------PDX------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
+
+    if (cur_power_stats.is_act_pd) {
+      cur_power_stats.act_pd_cycles += clk - cur_power_stats.low_power_start_cycle;
+      cur_power_stats.active_start_cycle = clk;
+      cur_power_stats.cur_power_state = PowerStats::PowerState::ACTIVE;
+    } else {
+      cur_power_stats.pre_pd_cycles += clk - cur_power_stats.low_power_start_cycle;
+      cur_power_stats.idle_start_cycle = clk;
+      cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
+    }
+    Rank::debug<T>(node, clk, "Power-down ends. act_pd_cycles: {}    pre_pd_cycles: {}", cur_power_stats.act_pd_cycles, cur_power_stats.pre_pd_cycles);
+  }
+
+  template <class T>
+  void SRE(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, clk, "------SRE------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
+
+    // All banks are closed before SRE
+    cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
+    cur_power_stats.low_power_start_cycle = clk;
+    Rank::debug<T>(node, clk, "Self-refresh starts. idle_cycles: {}", cur_power_stats.idle_cycles);
+    cur_power_stats.cur_power_state = PowerStats::PowerState::SELF_REFRESH;
+  }
+
+  template <class T>
+  void SRX(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, clk, "------SRX------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
+
+    cur_power_stats.sr_cycles += clk - cur_power_stats.low_power_start_cycle;
+    cur_power_stats.idle_start_cycle = clk;
+    Rank::debug<T>(node, clk, "Self-refresh ends. sr_cycles: {}", cur_power_stats.sr_cycles);
+    cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
+  }
+
   template <class T>
   void PREsb(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
 
+    // Only the target bank of every bankgroup needs to be checked: the rank goes idle if no other bank is open
     int open_target_banks = 0;
-    bool is_rank_going_idle = true;
+    int target_bank_id = addr_vec[T::m_levels["bank"]];
     for (auto bankgroup_node : node->m_child_nodes) {
-      for (auto bank_node : bankgroup_node->m_child_nodes) {
-        if (bank_node->m_state == T::m_states["Opened"]) {
-          if (bank_node->m_node_id == addr_vec[T::m_levels["bank"]]) {
-            open_target_banks++;
-          } else {
-            is_rank_going_idle = false;
-          }
-        }
+      if (bankgroup_node->m_child_nodes[target_bank_id]->m_state == T::m_states["Opened"]) {
+        open_target_banks++;
       }
     }
+    bool is_rank_going_idle = open_target_banks == cur_power_stats.num_open_banks;
 
     cur_power_stats.cmd_counters[T::m_cmds_counted("PRE")] += open_target_banks;
     if (is_rank_going_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
       cur_power_stats.idle_start_cycle = clk;
-      std::string msg = "Rank is going idle. active_cycles: " + std::to_string(cur_power_stats.active_cycles) + "    idle_start_cycle: " + std::to_string(cur_power_stats.idle_start_cycle);
-      Bank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is going idle. active_cycles: {}    idle_start_cycle: {}", cur_power_stats.active_cycles, cur_power_stats.idle_start_cycle);
       cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
     }
   }
 
   template <class T>
   void finalize_rank(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------finalize_rank------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------finalize_rank------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
 
     if (cur_power_stats.cur_power_state == PowerStats::PowerState::IDLE) {
       cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
@@ -342,6 +354,10 @@ namespace Rank {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
     } else if (cur_power_stats.cur_power_state == PowerStats::PowerState::REFRESHING) {
       // do nothing
+    } else if (cur_power_stats.cur_power_state == PowerStats::PowerState::POWER_DOWN) {
+      (cur_power_stats.is_act_pd ? cur_power_stats.act_pd_cycles : cur_power_stats.pre_pd_cycles) += clk - cur_power_stats.low_power_start_cycle;
+    } else if (cur_power_stats.cur_power_state == PowerStats::PowerState::SELF_REFRESH) {
+      cur_power_stats.sr_cycles += clk - cur_power_stats.low_power_start_cycle;
     }
   }
 
@@ -85,6 +85,36 @@ int RequireSameBanksClosed(typename T::Node* node, int cmd, const AddrVec_t& add
     return T::m_commands["PREsb"];
   }
 };
+
+/**
+ * @brief   Wakes the rank up from power-down or self-refresh before any other command.
+ *          Rank-scope commands are issued as is, others continue at the child level.
+ */
+template <class T>
+int RequirePoweredUp(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+  if (node->m_state == T::m_states["PowerDown"]) {
+    return T::m_commands["PDX"];
+  } else if (node->m_state == T::m_states["SelfRefresh"]) {
+    return T::m_commands["SRX"];
+  }
+  return T::m_command_scopes[cmd] == node->m_level ? cmd : -1;
+};
+
+template <class T>
+int RequirePoweredUpAllBanksClosed(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+  if (node->m_state != T::m_states["PowerUp"]) {
+    return RequirePoweredUp<T>(node, cmd, addr_vec, clk);
+  }
+  return RequireAllBanksClosed<T>(node, cmd, addr_vec, clk);
+};
+
+template <class T>
+int RequirePoweredUpSameBanksClosed(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+  if (node->m_state != T::m_states["PowerUp"]) {
+    return RequirePoweredUp<T>(node, cmd, addr_vec, clk);
+  }
+  return RequireSameBanksClosed<T>(node, cmd, addr_vec, clk);
+};
 }       // namespace Rank
 namespace Channel {
   template <class T>
@@ -44,9 +44,41 @@ struct DRAMNodeBase {
 
     int m_state = -1;      // The state of the node
 
+    int m_flat_rank_id = -1;  // Index of the rank into m_power_stats, set for rank and bank nodes when the power model is enabled
+
     std::vector<Clk_t> m_cmd_ready_clk;             // The next cycle that each command can be issued again at this level
     std::vector<std::deque<Clk_t>> m_cmd_history;   // Issue-history of each command at this level
 
+    /**
+     * @brief   The ready cycle of a command at my children due to the sibling timing constraints.
+     * @details
+     * A sibling constraint applies to every child except the one that the issued command targets. Instead of
+     * updating all the other children, the parent keeps the latest ready cycle with the child it came from, and the
+     * latest ready cycle that came from any other child, which is enough to get the ready cycle of every child.
+     */
+    struct SiblingReadyClk {
+      Clk_t latest = -1;
+      int   latest_child_id = -1;
+      Clk_t latest_from_others = -1;    // The latest ready cycle from children other than latest_child_id
+
+      void update(Clk_t ready_clk, int child_id) {
+        if (child_id == latest_child_id) {
+          latest = std::max(latest, ready_clk);
+        } else if (ready_clk > latest) {
+          latest_from_others = latest;
+          latest = ready_clk;
+          latest_child_id = child_id;
+        } else {
+          latest_from_others = std::max(latest_from_others, ready_clk);
+        }
+      };
+
+      Clk_t get(int child_id) const {
+        return child_id == latest_child_id ? latest_from_others : latest;
+      };
+    };
+    std::vector<SiblingReadyClk> m_child_sibling_ready_clk;   // Per command, if I have children
+
     using RowId_t = int;
     using RowState_t = int;
     std::map<RowId_t, RowState_t> m_row_state;  // The state of the rows, if I am a bank-ish node
@@ -80,6 +112,7 @@ struct DRAMNodeBase {
         if (next_level_size == 0) {
           return;
         } else {
+          m_child_sibling_ready_clk.resize(num_cmds);
           for (int i = 0; i < next_level_size; i++) {
             NodeType* child = new NodeType(spec, static_cast<NodeType*>(this), next_level, i);
             static_cast<NodeType*>(this)->m_child_nodes.push_back(child);
@@ -88,6 +121,16 @@ struct DRAMNodeBase {
       }
     };
 
+    /**
+     * @brief   Changes the state of a bank node, keeping the power stats of its rank up to date.
+     */
+    void set_state(int state) {
+      if (m_flat_rank_id != -1 && state != m_state) {
+        m_spec->track_bank_power_state(m_flat_rank_id, m_state, state);
+      }
+      m_state = state;
+    };
+
     void update_states(int command, const AddrVec_t& addr_vec, Clk_t clk) {
       int child_id = addr_vec[m_level+1];
       if (m_spec->m_actions[m_level][command]) {
@@ -132,24 +175,6 @@ struct DRAMNodeBase {
     };
 
     void update_timing(int command, const AddrVec_t& addr_vec, Clk_t clk) {
-      /************************************************
-       *         Update Sibling Node Timing
-       ***********************************************/
-      if (m_node_id != addr_vec[m_level] && addr_vec[m_level] != -1) {
-        for (const auto& t : m_spec->m_timing_cons[m_level][command]) {
-          if (!t.sibling) {
-            // not sibling timing parameter
-            continue; 
-          }
-
-          // update earliest schedulable time of every command
-          Clk_t future = clk + t.val;
-          m_cmd_ready_clk[t.cmd] = std::max(m_cmd_ready_clk[t.cmd], future); 
-        }
-        // stop recursion
-        return;
-      }
-
       /************************************************
        *          Update Target Node Timing
        ***********************************************/
@@ -181,10 +206,32 @@ struct DRAMNodeBase {
         return; 
       }
 
-      // recursively update all of my children
-      for (auto child : m_child_nodes) {
-        child->update_timing(command, addr_vec, clk);
+      int child_id = addr_vec[m_level+1];
+      if (child_id == -1) {
+        // recursively update all of my children, they are all targets
+        for (auto child : m_child_nodes) {
+          child->update_timing(command, addr_vec, clk);
+        }
+        return;
       }
+
+      /************************************************
+       *         Update Sibling Node Timing
+       ***********************************************/
+      // Recorded once here for all the siblings of the target child (see check_ready())
+      for (const auto& t : m_spec->m_timing_cons[m_level+1][command]) {
+        if (!t.sibling) {
+          // not sibling timing parameter
+          continue; 
+        }
+
+        // update earliest schedulable time of every command
+        Clk_t future = clk + t.val;
+        m_child_sibling_ready_clk[t.cmd].update(future, child_id);
+      }
+
+      // recursively update the target child
+      m_child_nodes[child_id]->update_timing(command, addr_vec, clk);
     };
 
     int get_preq_command(int command, const AddrVec_t& addr_vec, Clk_t m_clk) {
@@ -207,7 +254,12 @@ struct DRAMNodeBase {
     };
 
     bool check_ready(int command, const AddrVec_t& addr_vec, Clk_t clk) {
-      if (m_cmd_ready_clk[command] != -1 && clk < m_cmd_ready_clk[command]) {
+      Clk_t ready_clk = m_cmd_ready_clk[command];
+      if (m_parent_node) {
+        // fold in the sibling timing constraints recorded at my parent
+        ready_clk = std::max(ready_clk, m_parent_node->m_child_sibling_ready_clk[command].get(m_node_id));
+      }
+      if (ready_clk != -1 && clk < ready_clk) {
         // stop recursion: the check failed at this level
         return false; 
       }
@@ -300,12 +300,16 @@ struct PowerStats {
     enum class PowerState {
       IDLE = 0,
       ACTIVE = 1,
-      REFRESHING = 2
+      REFRESHING = 2,
+      POWER_DOWN = 3,
+      SELF_REFRESH = 4
     };
     PowerState cur_power_state = PowerState::IDLE;
 
     double act_background_energy = 0;
     double pre_background_energy = 0;
+    double pd_background_energy = 0;
+    double sr_background_energy = 0;
 
     double total_background_energy = 0;
     double total_cmd_energy = 0;
@@ -318,6 +322,16 @@ struct PowerStats {
 
     Clk_t active_start_cycle = -1; // initially rank is not active
     Clk_t idle_start_cycle = 0;
+
+    Clk_t act_pd_cycles = 0;       // Power-down with open banks
+    Clk_t pre_pd_cycles = 0;       // Power-down with all banks closed
+    Clk_t sr_cycles = 0;
+    Clk_t low_power_start_cycle = -1;
+    bool is_act_pd = false;        // Whether the current power-down started with open banks
+
+    // Kept up to date by the bank state transitions, so the power lambdas never scan the banks of the rank
+    int num_open_banks = 0;
+    int num_refreshing_banks = 0;
     
 };        
 
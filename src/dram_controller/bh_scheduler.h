@@ -10,6 +10,40 @@
 
 namespace Ramulator {
 
+/**
+ * @brief   An epoch of the lookups that a scheduler caches in the scratchpads of its requests.
+ * @details The scheduler advances the epoch whenever the cached lookups become stale. The epoch is an unsigned
+ *          64-bit counter and a request keeps its lower 32 bits in one scratchpad slot (see tag()).
+ */
+class SchedulerEpoch {
+  public:
+    void advance() {
+      // Tag 0 belongs to requests that were never checked, so it is skipped when the lower 32 bits wrap around
+      if (static_cast<uint32_t>(++m_epoch) == 0) {
+        m_epoch++;
+      }
+    }
+
+    int tag() const {
+      return static_cast<int>(static_cast<uint32_t>(m_epoch));
+    }
+
+    /**
+     * @brief   Tags the request with the current epoch in its scratchpad slot idx.
+     * @return  True if the request was tagged with an older epoch, i.e., its cached lookups must be redone.
+     */
+    bool retag(Request& req, int idx) const {
+      if (req.scratchpad[idx] == tag()) {
+        return false;
+      }
+      req.scratchpad[idx] = tag();
+      return true;
+    }
+
+  private:
+    uint64_t m_epoch = 1;
+};
+
 class IBHScheduler {
   RAMULATOR_REGISTER_INTERFACE(IBHScheduler, "BHScheduler", "Memory Controller Request Scheduler");
   
@@ -17,6 +51,11 @@ class IBHScheduler {
     virtual void tick() = 0;
     virtual ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) = 0;
     virtual ReqBuffer::iterator get_best_request(ReqBuffer& buffer) = 0;
+
+    /**
+     * @brief   Called by the controller after it issues a command, e.g., to invalidate cached DRAM lookups.
+     */
+    virtual void on_command_issued(int command, const AddrVec_t& addr_vec) { };
 };
 
 }       // namespace Ramulator
@@ -13,6 +13,7 @@
 #include "dram_controller/plugin.h"
 #include "dram_controller/refresh.h"
 #include "dram_controller/rowpolicy.h"
+#include "dram_controller/power_manager.h"
 
 
 namespace Ramulator {
@@ -25,6 +26,7 @@ class IDRAMController : public Clocked<IDRAMController> {
     IScheduler*   m_scheduler = nullptr;
     IRefreshManager*   m_refresh = nullptr;
     IRowPolicy*   m_rowpolicy = nullptr;
+    IPowerManager*   m_power_manager = nullptr;     // Optional
     std::vector<IControllerPlugin*> m_plugins;
 
     int m_channel_id = -1;
@@ -49,6 +51,12 @@ class IDRAMController : public Clocked<IDRAMController> {
      * 
      */
     virtual void tick() = 0;
+
+    /**
+     * @brief       Returns the current cycle of the memory controller.
+     * 
+     */
+    Clk_t get_clk() const { return m_clk; };
    
 };
 
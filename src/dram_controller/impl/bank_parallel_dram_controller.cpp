@@ -1,5 +1,8 @@
 #include "dram_controller/controller.h"
 #include "memory_system/memory_system.h"
+#include "dram_controller/impl/plugin/plugin_dispatcher/plugin_dispatcher.h"
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
+#include "dram_controller/impl/latency_stats/latency_stats.h"
 
 #include <algorithm>
 #include <deque>
@@ -26,6 +29,10 @@ class BankParallelDRAMController final : public IDRAMController,
   ReqBuffer m_read_buffer;      // Read request buffer
   ReqBuffer m_write_buffer;     // Write request buffer
 
+  PluginDispatcher m_plugin_dispatcher;  // Calls the plugins on the cycles they subscribed to
+  MitigationAccounting m_mitigation_accounting; // Attributes the cost of the RowHammer mitigations to them
+  LatencyStats m_latency_stats;         // Latency histograms of the demand requests
+
   int m_bank_addr_idx = -1;
 
   float m_wr_low_watermark;
@@ -86,6 +93,9 @@ class BankParallelDRAMController final : public IDRAMController,
     m_scheduler = create_child_ifce<IScheduler>();
     m_refresh = create_child_ifce<IRefreshManager>();
     m_rowpolicy = create_child_ifce<IRowPolicy>();
+    if (m_config["PowerManager"]) {
+      m_power_manager = create_child_ifce<IPowerManager>();
+    }
 
     if (m_config["plugins"]) {
       YAML::Node plugin_configs = m_config["plugins"];
@@ -98,6 +108,8 @@ class BankParallelDRAMController final : public IDRAMController,
 
   void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
     m_dram = memory_system->get_ifce<IDRAM>();
+    m_plugin_dispatcher.init(m_dram, m_plugins);
+    m_mitigation_accounting.init(m_dram, m_plugins, {&m_active_buffer, &m_read_buffer});
     m_bank_addr_idx = m_dram->m_levels("bank");
     m_priority_buffer.max_size = 512 * 3 + 32;
 
@@ -136,16 +148,17 @@ class BankParallelDRAMController final : public IDRAMController,
     register_stat(s_write_queue_len).name("write_queue_len_{}", m_channel_id);
     register_stat(s_priority_queue_len)
         .name("priority_queue_len_{}", m_channel_id);
-    register_stat(s_queue_len_avg).name("queue_len_avg_{}", m_channel_id);
+    register_stat(s_queue_len_avg).name("queue_len_avg_{}", m_channel_id).computed_at_finalize();
     register_stat(s_read_queue_len_avg)
-        .name("read_queue_len_avg_{}", m_channel_id);
+        .name("read_queue_len_avg_{}", m_channel_id).computed_at_finalize();
     register_stat(s_write_queue_len_avg)
-        .name("write_queue_len_avg_{}", m_channel_id);
+        .name("write_queue_len_avg_{}", m_channel_id).computed_at_finalize();
     register_stat(s_priority_queue_len_avg)
-        .name("priority_queue_len_avg_{}", m_channel_id);
+        .name("priority_queue_len_avg_{}", m_channel_id).computed_at_finalize();
 
     register_stat(s_read_latency).name("read_latency_{}", m_channel_id);
-    register_stat(s_avg_read_latency).name("avg_read_latency_{}", m_channel_id);
+    register_stat(s_avg_read_latency).name("avg_read_latency_{}", m_channel_id).computed_at_finalize();
+    m_latency_stats.register_stats(this, m_channel_id, m_num_cores);
   };
 
   bool send(Request& req) override {
@@ -191,6 +204,9 @@ class BankParallelDRAMController final : public IDRAMController,
       req.arrive = -1;
       return false;
     }
+    if (m_power_manager) {
+      m_power_manager->on_enqueue(req);
+    }
 
     return true;
   };
@@ -222,15 +238,18 @@ class BankParallelDRAMController final : public IDRAMController,
       ReqBuffer::iterator req_it;
       ReqBuffer* buffer = nullptr;
       bool request_found = schedule_request_filtered(req_it, buffer, used_access_banks);
+      if (m_power_manager) {
+        // Also called when nothing is issued, so that idle ranks can enter the low-power states
+        m_power_manager->update(request_found, req_it);
+      }
       if (!request_found) {
         break;
       }
 
       m_rowpolicy->update(request_found, req_it);
 
-      for (auto plugin : m_plugins) {
-        plugin->update(request_found, req_it);
-      }
+      m_plugin_dispatcher.update(m_clk, request_found, req_it);
+      m_mitigation_accounting.update(m_clk, request_found, req_it);
 
       if (req_it->is_stat_updated == false) {
         update_request_stats(req_it);
@@ -238,6 +257,7 @@ class BankParallelDRAMController final : public IDRAMController,
 
       const int command = req_it->command;
       m_dram->issue_command(command, req_it->addr_vec);
+      m_latency_stats.on_command(m_clk, *req_it);
 
       if (m_dram->m_command_meta(command).is_accessing) {
         used_access_banks.insert(bank_key(req_it->addr_vec));
@@ -313,6 +333,7 @@ class BankParallelDRAMController final : public IDRAMController,
         s_read_latency += req.depart - req.arrive;
       }
     }
+    m_latency_stats.on_depart(req);
 
     if (req.callback) {
       req.callback(req);
@@ -445,6 +466,8 @@ class BankParallelDRAMController final : public IDRAMController,
     s_read_queue_len_avg = (float)s_read_queue_len / (float)m_clk;
     s_write_queue_len_avg = (float)s_write_queue_len / (float)m_clk;
     s_priority_queue_len_avg = (float)s_priority_queue_len / (float)m_clk;
+
+    m_mitigation_accounting.finalize();
   }
 };
 
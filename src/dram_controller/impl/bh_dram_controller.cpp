@@ -3,6 +3,9 @@
 #include "frontend/frontend.h"
 #include "frontend/impl/processor/bhO3/bhllc.h"
 #include "frontend/impl/processor/bhO3/bhO3.h"
+#include "dram_controller/impl/plugin/plugin_dispatcher/plugin_dispatcher.h"
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
+#include "dram_controller/impl/latency_stats/latency_stats.h"
 
 namespace Ramulator {
 
@@ -22,6 +25,10 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
     ReqBuffer m_read_buffer;              // Read request buffer
     ReqBuffer m_write_buffer;             // Write request buffer
 
+    PluginDispatcher m_plugin_dispatcher; // Calls the plugins on the cycles they subscribed to
+    MitigationAccounting m_mitigation_accounting; // Attributes the cost of the RowHammer mitigations to them
+    LatencyStats m_latency_stats;         // Latency histograms of the demand requests
+
     int m_rank_addr_idx = -1;
     int m_bankgroup_addr_idx = -1;
     int m_bank_addr_idx = -1;
@@ -51,6 +58,9 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
       m_scheduler = create_child_ifce<IBHScheduler>();
       m_refresh = create_child_ifce<IRefreshManager>();
       m_rowpolicy = create_child_ifce<IRowPolicy>();
+      if (m_config["PowerManager"]) {
+        m_power_manager = create_child_ifce<IPowerManager>();
+      }
       m_logger = Logging::create_logger("DBHCTRL");
 
       if (m_config["plugins"]) {
@@ -64,6 +74,8 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
       m_llc = static_cast<BHO3*>(frontend)->get_llc();
       m_dram = memory_system->get_ifce<IDRAM>();
+      m_plugin_dispatcher.init(m_dram, m_plugins);
+      m_mitigation_accounting.init(m_dram, m_plugins, {&m_active_buffer, &m_read_buffer});
       m_rank_addr_idx = m_dram->m_levels("rank");
       m_bankgroup_addr_idx = m_dram->m_levels("bankgroup");
       m_bank_addr_idx = m_dram->m_levels("bank");
@@ -86,6 +98,7 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
       register_stat(s_num_row_hits).name("controller_num_row_hits");
       register_stat(s_num_row_misses).name("controller_num_row_misses");
       register_stat(s_num_row_conflicts).name("controller_num_row_conflicts");
+      m_latency_stats.register_stats(this, m_channel_id, num_cores);
     };
 
     bool send(Request& req) override {
@@ -119,6 +132,9 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
         req.arrive = -1;
         return false;
       }
+      if (m_power_manager) {
+        m_power_manager->on_enqueue(req);
+      }
 
       return true;
     };
@@ -147,15 +163,21 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
       // 2.1 RowPolicy
       m_rowpolicy->update(request_found, req_it);
 
-      // 3. Update all plugins
-      for (auto plugin : m_plugins) {
-        plugin->update(request_found, req_it);
+      // 2.2 PowerManager
+      if (m_power_manager) {
+        m_power_manager->update(request_found, req_it);
       }
 
+      // 3. Update all plugins
+      m_plugin_dispatcher.update(m_clk, request_found, req_it);
+      m_mitigation_accounting.update(m_clk, request_found, req_it);
+
       // 4. Finally, issue the commands to serve the request
       if (request_found) {
         // If we find a real request to serve
         m_dram->issue_command(req_it->command, req_it->addr_vec);
+        m_scheduler->on_command_issued(req_it->command, req_it->addr_vec);
+        m_latency_stats.on_command(m_clk, *req_it);
 
         // If we are issuing the last command, set depart clock cycle and move the request to the pending queue
         if (req_it->command == req_it->final_command) {
@@ -163,7 +185,8 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
             req_it->depart = m_clk + m_dram->m_read_latency;
             pending.push_back(*req_it);
           } else if (req_it->type_id == Request::Type::Write) {
-            // TODO: Add code to update statistics
+            req_it->depart = m_clk + 1;
+            m_latency_stats.on_depart(*req_it);
           }
           buffer->remove(req_it);
         } else {
@@ -193,7 +216,7 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
           // Request received data from dram
           if (req.depart - req.arrive > 1) {
             // Check if this requests accesses the DRAM or is being forwarded.
-            // TODO add the stats back
+            m_latency_stats.on_depart(req);
           }
 
           if (req.callback) {
@@ -306,6 +329,7 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
     }
 
     void finalize() override {
+      m_mitigation_accounting.finalize();
     }
 };
 }   // namespace Ramulator
@@ -1,5 +1,8 @@
 #include "dram_controller/controller.h"
 #include "memory_system/memory_system.h"
+#include "dram_controller/impl/plugin/plugin_dispatcher/plugin_dispatcher.h"
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
+#include "dram_controller/impl/latency_stats/latency_stats.h"
 
 namespace Ramulator {
 
@@ -13,6 +16,10 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
     ReqBuffer m_read_buffer;              // Read request buffer
     ReqBuffer m_write_buffer;             // Write request buffer
 
+    PluginDispatcher m_plugin_dispatcher; // Calls the plugins on the cycles they subscribed to
+    MitigationAccounting m_mitigation_accounting; // Attributes the cost of the RowHammer mitigations to them
+    LatencyStats m_latency_stats;         // Latency histograms of the demand requests
+
     int m_bank_addr_idx = -1;
 
     float m_wr_low_watermark;
@@ -58,6 +65,9 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       m_scheduler = create_child_ifce<IScheduler>();
       m_refresh = create_child_ifce<IRefreshManager>();    
       m_rowpolicy = create_child_ifce<IRowPolicy>();    
+      if (m_config["PowerManager"]) {
+        m_power_manager = create_child_ifce<IPowerManager>();
+      }
 
       if (m_config["plugins"]) {
         YAML::Node plugin_configs = m_config["plugins"];
@@ -69,6 +79,8 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
       m_dram = memory_system->get_ifce<IDRAM>();
+      m_plugin_dispatcher.init(m_dram, m_plugins);
+      m_mitigation_accounting.init(m_dram, m_plugins, {&m_active_buffer, &m_read_buffer});
       m_bank_addr_idx = m_dram->m_levels("bank");
       m_priority_buffer.max_size = 512*3 + 32;
 
@@ -101,13 +113,14 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       register_stat(s_read_queue_len).name("read_queue_len_{}", m_channel_id);
       register_stat(s_write_queue_len).name("write_queue_len_{}", m_channel_id);
       register_stat(s_priority_queue_len).name("priority_queue_len_{}", m_channel_id);
-      register_stat(s_queue_len_avg).name("queue_len_avg_{}", m_channel_id);
-      register_stat(s_read_queue_len_avg).name("read_queue_len_avg_{}", m_channel_id);
-      register_stat(s_write_queue_len_avg).name("write_queue_len_avg_{}", m_channel_id);
-      register_stat(s_priority_queue_len_avg).name("priority_queue_len_avg_{}", m_channel_id);
+      register_stat(s_queue_len_avg).name("queue_len_avg_{}", m_channel_id).computed_at_finalize();
+      register_stat(s_read_queue_len_avg).name("read_queue_len_avg_{}", m_channel_id).computed_at_finalize();
+      register_stat(s_write_queue_len_avg).name("write_queue_len_avg_{}", m_channel_id).computed_at_finalize();
+      register_stat(s_priority_queue_len_avg).name("priority_queue_len_avg_{}", m_channel_id).computed_at_finalize();
 
       register_stat(s_read_latency).name("read_latency_{}", m_channel_id);
-      register_stat(s_avg_read_latency).name("avg_read_latency_{}", m_channel_id);
+      register_stat(s_avg_read_latency).name("avg_read_latency_{}", m_channel_id).computed_at_finalize();
+      m_latency_stats.register_stats(this, m_channel_id, m_num_cores);
     };
 
     bool send(Request& req) override {
@@ -156,6 +169,9 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
         req.arrive = -1;
         return false;
       }
+      if (m_power_manager) {
+        m_power_manager->on_enqueue(req);
+      }
 
       return true;
     };
@@ -190,11 +206,15 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       // 2.1 Take row policy action
       m_rowpolicy->update(request_found, req_it);
 
-      // 3. Update all plugins
-      for (auto plugin : m_plugins) {
-        plugin->update(request_found, req_it);
+      // 2.2 Let the power manager track the rank activity and enter the low-power states
+      if (m_power_manager) {
+        m_power_manager->update(request_found, req_it);
       }
 
+      // 3. Update all plugins
+      m_plugin_dispatcher.update(m_clk, request_found, req_it);
+      m_mitigation_accounting.update(m_clk, request_found, req_it);
+
       // 4. Finally, issue the commands to serve the request
       if (request_found) {
         // If we find a real request to serve
@@ -202,6 +222,7 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
           update_request_stats(req_it);
         }
         m_dram->issue_command(req_it->command, req_it->addr_vec);
+        m_latency_stats.on_command(m_clk, *req_it);
 
         // If we are issuing the last command, set depart clock cycle and move the request to the pending queue
         if (req_it->command == req_it->final_command) {
@@ -309,10 +330,10 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
         // Request received data from dram
         if (req.depart - req.arrive > 1) {
           // Check if this requests accesses the DRAM or is being forwarded.
-          // TODO add the stats back
           s_read_latency += req.depart - req.arrive;
         }
       }
+      m_latency_stats.on_depart(req);
 
       if (req.callback) {
         // If the request comes from outside (e.g., processor), call its callback
@@ -412,6 +433,8 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       s_write_queue_len_avg = (float) s_write_queue_len / (float) m_clk;
       s_priority_queue_len_avg = (float) s_priority_queue_len / (float) m_clk;
 
+      m_mitigation_accounting.finalize();
+
       return;
     }
 
@@ -0,0 +1,23 @@
+#include "dram_controller/impl/latency_stats/latency_stats.h"
+
+namespace Ramulator {
+
+void LatencyStats::register_stats(Implementation* ctrl, int channel_id, int num_cores) {
+    const char* type_names[NUM_TYPES] = {"read", "write"};
+    for (int type = 0; type < NUM_TYPES; type++) {
+        ctrl->register_stat(s_latency[type]).name("{}_latency_hist_{}", type_names[type], channel_id)
+                                             .desc("Cycles from arriving at the controller until departing");
+        ctrl->register_stat(s_queueing_delay[type]).name("{}_queueing_delay_hist_{}", type_names[type], channel_id)
+                                                   .desc("Cycles from arriving at the controller until the first command");
+        ctrl->register_stat(s_service_time[type]).name("{}_service_time_hist_{}", type_names[type], channel_id)
+                                                 .desc("Cycles from the first command until departing");
+    }
+
+    s_read_latency_per_core.resize(num_cores);
+    for (int core_id = 0; core_id < num_cores; core_id++) {
+        ctrl->register_stat(s_read_latency_per_core[core_id]).name("read_latency_hist_core_{}_{}", core_id, channel_id)
+                                                             .desc("Cycles from arriving at the controller until departing, for the reads of the core");
+    }
+}
+
+}   // namespace Ramulator
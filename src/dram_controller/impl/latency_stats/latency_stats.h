@@ -0,0 +1,70 @@
+#ifndef RAMULATOR_CONTROLLER_LATENCYSTATS_H
+#define RAMULATOR_CONTROLLER_LATENCYSTATS_H
+
+#include <vector>
+
+#include "base/base.h"
+#include "base/request.h"
+
+namespace Ramulator {
+
+/**
+ * @brief   Latency histograms of the demand requests served by a controller, per request type and per core.
+ * @details
+ * The latency of a request (arrive -> depart) is split into its queueing delay (arrive -> first command) and its
+ * DRAM service time (first command -> depart). Only requests that are served by the DRAM are recorded (e.g., reads
+ * forwarded from the write buffer and maintenance requests are not).
+ */
+class LatencyStats {
+public:
+    /**
+     * @brief   Registers the histograms in ctrl (call in setup(), once the number of cores is known).
+     */
+    void register_stats(Implementation* ctrl, int channel_id, int num_cores);
+
+    /**
+     * @brief   Timestamps the first command of req (call whenever a command is issued for req).
+     */
+    void on_command(Clk_t clk, Request& req) {
+        if (req.issue == -1) {
+            req.issue = clk;
+        }
+    };
+
+    /**
+     * @brief   Records req when it departs the controller (req.depart must be set).
+     */
+    void on_depart(const Request& req) {
+        if (req.arrive == -1 || req.issue == -1) {
+            return;
+        }
+        int type = -1;
+        if (req.type_id == Request::Type::Read) {
+            type = READ;
+        } else if (req.type_id == Request::Type::Write) {
+            type = WRITE;
+        } else {
+            return;
+        }
+
+        uint64_t latency = req.depart - req.arrive;
+        s_latency[type].record(latency);
+        s_queueing_delay[type].record(req.issue - req.arrive);
+        s_service_time[type].record(req.depart - req.issue);
+        if (type == READ && req.source_id >= 0 && req.source_id < (int) s_read_latency_per_core.size()) {
+            s_read_latency_per_core[req.source_id].record(latency);
+        }
+    };
+
+private:
+    enum { READ = 0, WRITE = 1, NUM_TYPES };
+
+    Histogram s_latency[NUM_TYPES];
+    Histogram s_queueing_delay[NUM_TYPES];
+    Histogram s_service_time[NUM_TYPES];
+    std::vector<Histogram> s_read_latency_per_core;
+};
+
+}       // namespace Ramulator
+
+#endif  // RAMULATOR_CONTROLLER_LATENCYSTATS_H
@@ -1,7 +1,6 @@
 #include <vector>
 #include <unordered_map>
 #include <limits>
-#include <random>
 
 #include "base/base.h"
 #include "dram_controller/controller.h"
@@ -9,6 +8,9 @@
 #include "translation/translation.h"
 #include "addr_mapper/impl/rit.h"
 #include "dram_controller/impl/plugin/device_config/device_config.h"
+#include "dram_controller/impl/plugin/frequent_item_tracker/frequent_item_tracker.h"
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
+#include "dram_controller/impl/plugin/row_swap_engine/row_swap_engine.h"
 
 namespace Ramulator {
 
@@ -21,8 +23,6 @@ class AQUA : public IControllerPlugin, public Implementation {
     ITranslation* m_translation = nullptr;
     DeviceConfig m_cfg;
 
-    Clk_t m_clk = 0;
-
     int m_num_art_entries = -1;
     int m_num_fpt_entries = -1;
     int m_num_qrows_per_bank = -1;
@@ -33,9 +33,6 @@ class AQUA : public IControllerPlugin, public Implementation {
 
     int m_rqa_head = 0;
 
-    int m_RD_req_id = -1;
-    int m_WR_req_id = -1;
-
     int m_rank_level = -1;
     int m_bank_level = -1;
     int m_row_level = -1;
@@ -44,27 +41,23 @@ class AQUA : public IControllerPlugin, public Implementation {
     int m_num_ranks = -1;
     int m_num_banks_per_rank = -1;
     int m_num_rows_per_bank = -1;
-    int m_num_cls = -1;
 
     // per bank hot-row tracker (same as Graphene)
     // indexed using flattened <rank id, bank id>
     // e.g., if rank 0, bank 4, index is 4
     // if rank 1, bank 5, index is 16 (assuming 16 banks/rank) + 5
-    std::vector<std::unordered_map<int, int>> m_aggressor_row_tracker;
-    // spillover counter per bank
-    std::vector<int> m_spillover_counter;
+    FrequentItemTracker m_aggressor_row_tracker;
     // per bank row indirection table is implemented in 'src/addr_mapper/impl/linear_mappers_with_rit.cpp'
 
     std::vector<std::unordered_map<int, int>> m_reverse_pointer_table;
 
-    // rng
-    std::mt19937 generator;
-    std::uniform_int_distribution<int> distribution;
-
     // statistics
     int s_num_migrations = 0;
     int s_num_r_migrations = 0;
 
+    MitigationStats m_mitigation;
+    RowSwapEngine m_swap_engine;
+
   public:
     void init() override { 
       m_num_art_entries = param<int>("num_art_entries").required();
@@ -73,6 +66,12 @@ class AQUA : public IControllerPlugin, public Implementation {
       m_art_threshold = param<int>("art_threshold").required();
       m_reset_period_ns = param<int>("reset_period_ns").required();
       m_is_debug = param<bool>("debug").default_val(false);
+
+      // The swap engine needs to see its RD/WRs complete
+      subscribe_commands(OpeningCommands | AccessingCommands);
+
+      m_mitigation.register_stats(this);
+      m_mitigation_stats = &m_mitigation;
     }
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
@@ -84,9 +83,11 @@ class AQUA : public IControllerPlugin, public Implementation {
       m_cfg.set_device(m_ctrl);
 
       m_reset_period_clk = m_reset_period_ns / ((float) m_dram->m_timing_vals("tCK_ps") / 1000.0f);
-
-      m_RD_req_id = m_dram->m_requests("read");
-      m_WR_req_id = m_dram->m_requests("write");
+      subscribe_timer(m_reset_period_clk, [this]() {
+        // Reset hrt and unlock rit
+        m_aggressor_row_tracker.reset();
+        // m_addr_mapper->rit_unlock();
+      });
 
       m_rank_level = m_dram->m_levels("rank");
       m_bank_level = m_dram->m_levels("bank");
@@ -98,26 +99,19 @@ class AQUA : public IControllerPlugin, public Implementation {
                              m_dram->get_level_size("bank") : 
                              m_dram->get_level_size("bankgroup") * m_dram->get_level_size("bank");
       m_num_rows_per_bank = m_dram->get_level_size("row");
-      m_num_cls = m_dram->get_level_size("column") / 8;
 
       // Initialize hot-row tracker
+      m_aggressor_row_tracker.init(m_num_banks_per_rank * m_num_ranks, m_num_art_entries);
       for (int i = 0; i < m_num_banks_per_rank * m_num_ranks; i++) {
-        std::unordered_map<int, int> table;
-        m_aggressor_row_tracker.push_back(table);
-
         std::unordered_map<int, int> rpt;
         m_reverse_pointer_table.push_back(rpt);
       }
-      // Initialize spillover counter
-      m_spillover_counter = std::vector<int>(m_num_banks_per_rank * m_num_ranks, 0);
       // Initialize row indirection table in the addr_mapper
       m_addr_mapper->init_rit(m_num_banks_per_rank * m_num_ranks, m_num_fpt_entries * 2);
 
       reserve_rows_for_aqua();
-      
-      // setup random number generator
-      generator = std::mt19937(1337);
-      distribution = std::uniform_int_distribution<int>(0, m_num_rows_per_bank-1);
+
+      m_swap_engine.init(this, m_ctrl, m_mitigation);
 
       // Register statistics
       register_stat(s_num_migrations).name("aqua_migrations");
@@ -135,20 +129,13 @@ class AQUA : public IControllerPlugin, public Implementation {
     }
 
     void update(bool request_found, ReqBuffer::iterator& req_it) override {
-      // Tick myself
-      m_clk++;
-
-      if (m_clk % m_reset_period_clk == 0) {
-        // Reset hrt and unlock rit
-        for (int i = 0; i < m_num_banks_per_rank * m_num_ranks; i++) {
-          m_aggressor_row_tracker[i].clear();
-          m_spillover_counter[i] = 0;
-          // m_addr_mapper->rit_unlock();
-        }
-      }
+      m_swap_engine.update(request_found, req_it);
 
       if (request_found) {
-        if (m_dram->m_command_meta(req_it->command).is_opening && m_dram->m_command_scopes(req_it->command) == m_row_level) {
+        // The copies of the swap engine re-open the rows they move whenever demand requests interleave with them,
+        // which a real swap buffer would not do, so they are not tracked
+        if (m_dram->m_command_meta(req_it->command).is_opening && m_dram->m_command_scopes(req_it->command) == m_row_level &&
+            !m_swap_engine.is_engine_request(*req_it)) {
           int flat_bank_id = req_it->addr_vec[m_bank_level];
           int accumulated_dimension = 1;
           for (int i = m_bank_level - 1; i >= m_rank_level; i--) {
@@ -160,78 +147,28 @@ class AQUA : public IControllerPlugin, public Implementation {
 
           if (m_is_debug) {
             std::cout << "----------------------------" << std::endl;
-            std::cout << "AQUA: ACT on row " << row_id << "         " << m_clk << std::endl;
+            std::cout << "AQUA: ACT on row " << row_id << "         " << m_ctrl->get_clk() << std::endl;
             std::cout << "  └  " << "bank: " << flat_bank_id << std::endl;
           }
 
           // Check HRT
-          if (m_aggressor_row_tracker[flat_bank_id].find(row_id) == m_aggressor_row_tracker[flat_bank_id].end()) {
+          // if the row is not in the table and the table is full, it evicts a row with the spillover counter value,
+          // or, if there is no such row, the spillover counter is incremented
+          int count = m_aggressor_row_tracker.increment(flat_bank_id, row_id);
+          if (count == -1) {
             if (m_is_debug) {
-              std::cout << "  └  " << "row " << row_id << " not in HRT." << std::endl;
-            }
-            // if row is not in the table, check if the table is full 
-            if (m_aggressor_row_tracker[flat_bank_id].size() < m_num_art_entries) {
-              if (m_is_debug) {
-                std::cout << "  └  " << "HRT is not full, inserting with count 1." << std::endl;
-              }
-              // if table is not full, insert the row
-              m_aggressor_row_tracker[flat_bank_id][row_id] = 1;
-            } else {
-              if (m_is_debug) {
-                std::cout << "  └  " << "HRT is full, searching for a row to evict." << std::endl;
-              }
-              // if table is full, find a row to evict
-              bool found = false;
-              int to_remove = -1;
-              int spillover_value = -1;
-
-              for (auto it = m_aggressor_row_tracker[flat_bank_id].begin(); it != m_aggressor_row_tracker[flat_bank_id].end(); it++) {
-                // if we find an entry with spillover counter value, evict it
-                if (it->second == m_spillover_counter[flat_bank_id]) {
-                  if (m_is_debug) {
-                    std::cout << "  └  " << "found a row to evict: " << it->first << std::endl;
-                  }
-                  // if we find an entry, record it
-                  spillover_value = it->second;
-                  to_remove = it->first;
-                  found = true;
-                  break;
-                }
-              }
-
-              if (found) {
-                if (m_is_debug) {
-                  std::cout << "Removing row " << to_remove << " from HRT." << std::endl;
-                  std::cout << "Adding row " << row_id << " to HRT." << std::endl;
-                }
-                // remove to_remove from the table
-                m_aggressor_row_tracker[flat_bank_id].erase(to_remove);
-                // add row_id to the table
-                m_aggressor_row_tracker[flat_bank_id][row_id] = spillover_value + 1;
-              }
-              else {
-                if (m_is_debug) {
-                  std::cout << "  └  " << "no row to evict, incrementing spillover counter." << std::endl;
-                }
-                m_spillover_counter[flat_bank_id] += 1;
-                return;
-              }
+              std::cout << "  └  " << "row " << row_id << " not in HRT and no row to evict, incrementing spillover counter." << std::endl;
             }
-          } else {
-            if (m_is_debug) { 
-              std::cout << "  └  " << "row " << row_id << " in HRT. Incrementing its counter." << std::endl;
-            }
-            // if row in table, increment its activation count
-            m_aggressor_row_tracker[flat_bank_id][row_id] += 1;
+            return;
           }
           // dump HRT for debug
           // if (m_is_debug) {
           //   std::cout << "==========================" << std::endl;
-          //   std::cout << "HRT[" << flat_bank_id << "].size(): " << m_hot_row_tracker[flat_bank_id].size() << std::endl;
-          //   for (auto entry: m_hot_row_tracker[flat_bank_id]) {
-          //     std::cout << entry.first << ":\t" << entry.second << std::endl; 
-          //   }
-          //   std::cout << "Spillover counter: " << m_spillover_counter[flat_bank_id] << std::endl;
+          //   std::cout << "HRT[" << flat_bank_id << "].size(): " << m_aggressor_row_tracker.get_size(flat_bank_id) << std::endl;
+          //   m_aggressor_row_tracker.for_each(flat_bank_id, [](int row, int row_count) {
+          //     std::cout << row << ":\t" << row_count << std::endl; 
+          //   });
+          //   std::cout << "Spillover counter: " << m_aggressor_row_tracker.get_spillover(flat_bank_id) << std::endl;
           //   std::cout << "==========================" << std::endl;
           // }
 
@@ -239,9 +176,9 @@ class AQUA : public IControllerPlugin, public Implementation {
           if (m_is_debug) {
             std::cout << "Row " << row_id << " in ART" << std::endl;
             std::cout << "  └  " << "threshold: " << m_art_threshold << std::endl;
-            std::cout << "  └  " << "count: " << m_aggressor_row_tracker[flat_bank_id][row_id] << std::endl;
+            std::cout << "  └  " << "count: " << count << std::endl;
           }
-          if (m_aggressor_row_tracker[flat_bank_id][row_id] % m_art_threshold == 0) {
+          if (count % m_art_threshold == 0) {
             if (m_is_debug) {
               std::cout << "Row " << row_id << " needs quarantine!" << std::endl;
               std::cout << "  └  " << "RQA head: " << m_rqa_head << std::endl;
@@ -300,33 +237,7 @@ class AQUA : public IControllerPlugin, public Implementation {
     }
 
     void issue_migration(ReqBuffer::iterator& req_it, int src_row, int dst_row) {
-      // load addr_vec
-      std::vector<int> addr_vec;
-      for (int i = 0; i < req_it->addr_vec.size(); i++){
-        addr_vec.push_back(req_it->addr_vec[i]);
-      }
-
-      // Read src_row to copy buffer 
-      addr_vec[m_row_level] = src_row;
-      for (int cl = 0; cl < m_num_cls; cl++){
-        addr_vec[m_col_level] = cl << 3;
-        Request swap_read_req(addr_vec, m_RD_req_id);
-        if (!m_ctrl->priority_send(swap_read_req)){
-          std::cerr << "Check priority queue max size." << std::endl;
-          exit(1);
-        }
-      }
-
-      // Write copy buffer to dst_row
-      addr_vec[m_row_level] = dst_row;
-      for (int cl = 0; cl < m_num_cls; cl++){
-        addr_vec[m_col_level] = cl << 3;
-        Request swap_write_req(addr_vec, m_WR_req_id);
-        if (!m_ctrl->priority_send(swap_write_req)){
-          std::cerr << "Check priority queue max size." << std::endl;
-          exit(1);
-        }
-      }
+      m_swap_engine.enqueue_migration(req_it->addr_vec, src_row, dst_row);
     }
 
     void reserve_rows_for_aqua() {
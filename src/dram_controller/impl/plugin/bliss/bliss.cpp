@@ -16,13 +16,10 @@ class BLISS : public IControllerPlugin, public Implementation, public IBLISS {
 
 private:
     DeviceConfig m_cfg;
-    std::vector<bool> m_blacklist_info;
 
     int m_prev_src_id = -1;
     int m_consequtive_src_id = -1;
 
-    uint64_t m_clk = 0;
-
     int m_blacklist_thresh = -1;
     int m_unblacklist_cycles = -1;
 
@@ -40,10 +37,18 @@ public:
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
         m_cfg.set_device(cast_parent<IDRAMController>());
 
-        m_blacklist_info.resize(frontend->get_num_cores());
+        if (frontend->get_num_cores() > MAX_SOURCES) {
+            throw ConfigurationError("[BLISS] At most {} cores are supported, but there are {}!", MAX_SOURCES, frontend->get_num_cores());
+        }
 
         m_consequtive_src_id = 0;
 
+        // Every command counts towards the consecutive commands of its source
+        subscribe_commands(AllCommands);
+        subscribe_timer(m_unblacklist_cycles, [this]() {
+            m_blacklist_mask = 0;
+        });
+
         m_cmd_rd = m_cfg.m_dram->m_commands("RD");
         m_cmd_wr = m_cfg.m_dram->m_commands("WR");
 
@@ -51,14 +56,6 @@ public:
     }
 
     void update(bool request_found, ReqBuffer::iterator& req_it) override {
-        m_clk++;
-
-        if (m_clk % m_unblacklist_cycles == 0) {
-            for (int i = 0; i < m_blacklist_info.size(); i++) {
-                m_blacklist_info[i] = false;
-            }
-        }
-
         if (!request_found) {
             return;
         }
@@ -77,18 +74,14 @@ public:
         }
 
         // Branchless execution, if already blacklisted or exceeding threshold set blacklisted
-        // m_blacklist_info[req_it->source_id] = m_blacklist_info[req_it->source_id] || m_consequtive_src_id >= m_blacklist_thresh; 
+        // m_blacklist_mask |= uint64_t(m_consequtive_src_id >= m_blacklist_thresh) << req_it->source_id;
         // s_blacklist_count += (m_consequtive_src_id >= m_blacklist_thresh);
 
         if (m_consequtive_src_id >= m_blacklist_thresh) {
-            m_blacklist_info[req_it->source_id] = true;
+            m_blacklist_mask |= uint64_t(1) << req_it->source_id;
             s_blacklist_count++;
         }
     }
-
-    virtual bool is_blacklisted(int source_id) override {
-        return source_id < 0 || m_blacklist_info[source_id];
-    }
 };      // class BLISS
 
 }       // namespace Ramulator
\ No newline at end of file
@@ -1,13 +1,27 @@
 #ifndef RAMULATOR_PLUGIN_BLISS_H_
 #define RAMULATOR_PLUGIN_BLISS_H_
 
+#include <cstdint>
+
 namespace Ramulator {
 
 class IBLISS {
 public:
-    virtual bool is_blacklisted(int source_id) = 0;
+    static constexpr int MAX_SOURCES = 64;
+
+    /**
+     * @brief   Bit i is set if source i is blacklisted. Schedulers read it directly every cycle.
+     */
+    uint64_t get_blacklist_mask() const { return m_blacklist_mask; }
+
+    bool is_blacklisted(int source_id) const {
+        return source_id < 0 || (m_blacklist_mask >> source_id) & 1;
+    }
+
+protected:
+    uint64_t m_blacklist_mask = 0;
 };
 
 }
 
-#endif  // RAMULATOR_PLUGIN_BLISS_H_ 
\ No newline at end of file
+#endif  // RAMULATOR_PLUGIN_BLISS_H_ 
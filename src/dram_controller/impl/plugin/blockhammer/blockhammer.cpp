@@ -6,6 +6,7 @@
 #include "dram_controller/plugin.h"
 #include "frontend/impl/processor/bhO3/bhllc.h"
 #include "frontend/impl/processor/bhO3/bhO3.h"
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
 
 #include <queue>
 #include <unordered_map>
@@ -58,6 +59,7 @@ class BlockHammer : public IControllerPlugin, public Implementation, public IBlo
     std::unordered_set<int> m_blacklisted_rows;
     std::vector<std::unordered_map<int ,int>*> m_activations; 
     AttackThrottler* m_attack_throttler;
+    MitigationStats m_mitigation;
 
     int m_clk = -1;
     
@@ -98,6 +100,9 @@ class BlockHammer : public IControllerPlugin, public Implementation, public IBlo
       m_bf_trc = param<int>("bf_trc").default_val(75);
       m_bf_hist_max_freq = param<int>("bf_hist_max_freq").default_val(1);
       m_is_debug = param<bool>("debug").default_val(false);
+
+      m_mitigation.register_stats(this);
+      m_mitigation_stats = &m_mitigation;
     }
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
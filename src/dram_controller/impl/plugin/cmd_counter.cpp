@@ -33,6 +33,8 @@ class CommandCounter : public IControllerPlugin, public Implementation {
       if (!(std::filesystem::exists(parent_path) && std::filesystem::is_directory(parent_path))) {
         throw ConfigurationError("Invalid path to trace file: {}", parent_path.string());
       }
+
+      subscribe_commands(AllCommands);
     };
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
@@ -0,0 +1,208 @@
+#include "dram_controller/impl/plugin/frequent_item_tracker/frequent_item_tracker.h"
+
+namespace Ramulator {
+
+void FrequentItemTracker::init(int num_tables, int num_entries) {
+    m_num_tables = num_tables;
+    m_num_entries = num_entries;
+
+    m_tables.assign(num_tables, Table());
+    m_entries.assign((size_t) num_tables * num_entries, {-1, -1, -1, -1});
+    m_buckets.assign((size_t) num_tables * num_entries, {0, -1, -1, -1, -1});
+    m_index.init(num_tables, num_entries);
+    m_epoch = 1;
+}
+
+void FrequentItemTracker::reset() {
+    m_epoch++;
+}
+
+int FrequentItemTracker::increment(int table_id, int key) {
+    Table& table = get_table(table_id);
+    Entry* entries = &m_entries[(size_t) table_id * m_num_entries];
+    Bucket* buckets = &m_buckets[(size_t) table_id * m_num_entries];
+
+    int e = find_entry(table_id, key);
+    if (e != -1) {
+        // Tracked: move to the next bucket
+        int bucket = entries[e].bucket;
+        int count = buckets[bucket].count + 1;
+        int next = buckets[bucket].next;
+        if (buckets[bucket].head == e && buckets[bucket].tail == e && (next == -1 || buckets[next].count != count)) {
+            // The only entry of its bucket: bump the count in place
+            buckets[bucket].count = count;
+            return count;
+        }
+        // Otherwise the bucket stays alive, so there is always a free bucket for the target
+        int target = find_or_create_bucket(table_id, count, bucket);
+        detach(table_id, e);
+        attach(table_id, e, target);
+        return count;
+    }
+
+    if (table.size < m_num_entries) {
+        e = table.size++;
+    } else if (buckets[table.min_bucket].count == table.spillover) {
+        // Replace the oldest entry with the minimum count
+        e = buckets[table.min_bucket].head;
+        m_index.erase(table_id, entries[e].key);
+        detach(table_id, e);
+    } else {
+        table.spillover++;
+        return -1;
+    }
+
+    int count = table.spillover + 1;
+    entries[e].key = key;
+    m_index.insert(table_id, key, e);
+    attach(table_id, e, find_or_create_bucket(table_id, count, table.min_bucket));
+    return count;
+}
+
+void FrequentItemTracker::reset_to_spillover(int table_id, int key) {
+    int e = find_entry(table_id, key);
+    if (e == -1) {
+        return;
+    }
+    Table& table = get_table(table_id);
+    detach(table_id, e);
+    // The spillover counter is a lower bound of all counts, so the target is at the head of the list
+    Bucket* buckets = &m_buckets[(size_t) table_id * m_num_entries];
+    int target = table.min_bucket;
+    if (target == -1 || buckets[target].count != table.spillover) {
+        target = alloc_bucket(table_id, table.spillover, -1, table.min_bucket);
+    }
+    attach(table_id, e, target);
+}
+
+int FrequentItemTracker::get_count(int table_id, int key) const {
+    int e = find_entry(table_id, key);
+    if (e == -1) {
+        return -1;
+    }
+    int bucket = m_entries[(size_t) table_id * m_num_entries + e].bucket;
+    return m_buckets[(size_t) table_id * m_num_entries + bucket].count;
+}
+
+int FrequentItemTracker::get_spillover(int table_id) const {
+    return m_tables[table_id].epoch == m_epoch ? m_tables[table_id].spillover : 0;
+}
+
+int FrequentItemTracker::get_size(int table_id) const {
+    return m_tables[table_id].epoch == m_epoch ? m_tables[table_id].size : 0;
+}
+
+FrequentItemTracker::Table& FrequentItemTracker::get_table(int table_id) {
+    Table& table = m_tables[table_id];
+    if (table.epoch != m_epoch) {
+        // Lazily reset the table
+        table = Table();
+        table.epoch = m_epoch;
+        m_index.clear(table_id);
+    }
+    return table;
+}
+
+int FrequentItemTracker::find_entry(int table_id, int key) const {
+    // The index of a table from an older epoch is stale until the table is reset
+    if (m_tables[table_id].epoch != m_epoch) {
+        return -1;
+    }
+    return m_index.find(table_id, key);
+}
+
+int FrequentItemTracker::alloc_bucket(int table_id, int count, int prev, int next) {
+    Table& table = m_tables[table_id];
+    Bucket* buckets = &m_buckets[(size_t) table_id * m_num_entries];
+
+    int b = table.free_bucket;
+    if (b != -1) {
+        table.free_bucket = buckets[b].next;
+    } else {
+        b = table.num_buckets++;
+    }
+    buckets[b] = {count, -1, -1, prev, next};
+    if (prev != -1) {
+        buckets[prev].next = b;
+    } else {
+        table.min_bucket = b;
+    }
+    if (next != -1) {
+        buckets[next].prev = b;
+    }
+    return b;
+}
+
+int FrequentItemTracker::find_or_create_bucket(int table_id, int count, int from_bucket) {
+    Table& table = m_tables[table_id];
+    Bucket* buckets = &m_buckets[(size_t) table_id * m_num_entries];
+
+    // Walk forward from from_bucket (the head, or a bucket with a smaller count) to the insertion point
+    int prev = -1;
+    int b = from_bucket;
+    if (b != -1) {
+        prev = buckets[b].prev;
+    } else {
+        b = table.min_bucket;
+    }
+    while (b != -1 && buckets[b].count < count) {
+        prev = b;
+        b = buckets[b].next;
+    }
+    if (b != -1 && buckets[b].count == count) {
+        return b;
+    }
+    return alloc_bucket(table_id, count, prev, b);
+}
+
+void FrequentItemTracker::attach(int table_id, int entry, int bucket) {
+    Entry* entries = &m_entries[(size_t) table_id * m_num_entries];
+    Bucket& b = m_buckets[(size_t) table_id * m_num_entries + bucket];
+
+    entries[entry].bucket = bucket;
+    entries[entry].prev = b.tail;
+    entries[entry].next = -1;
+    if (b.tail != -1) {
+        entries[b.tail].next = entry;
+    } else {
+        b.head = entry;
+    }
+    b.tail = entry;
+}
+
+void FrequentItemTracker::detach(int table_id, int entry) {
+    Table& table = m_tables[table_id];
+    Entry* entries = &m_entries[(size_t) table_id * m_num_entries];
+    Bucket* buckets = &m_buckets[(size_t) table_id * m_num_entries];
+
+    Entry& e = entries[entry];
+    int bucket = e.bucket;
+    Bucket& b = buckets[bucket];
+    if (e.prev != -1) {
+        entries[e.prev].next = e.next;
+    } else {
+        b.head = e.next;
+    }
+    if (e.next != -1) {
+        entries[e.next].prev = e.prev;
+    } else {
+        b.tail = e.prev;
+    }
+    e.bucket = -1;
+
+    if (b.head == -1) {
+        // Unlink the empty bucket and put it on the free list
+        if (b.prev != -1) {
+            buckets[b.prev].next = b.next;
+        } else {
+            table.min_bucket = b.next;
+        }
+        if (b.next != -1) {
+            buckets[b.next].prev = b.prev;
+        }
+        b.next = table.free_bucket;
+        table.free_bucket = bucket;
+    }
+}
+
+}   // namespace Ramulator
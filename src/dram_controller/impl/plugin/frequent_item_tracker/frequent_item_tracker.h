@@ -0,0 +1,112 @@
+#ifndef RAMULATOR_PLUGUTIL_FREQUENTITEMTRACKER_H
+#define RAMULATOR_PLUGUTIL_FREQUENTITEMTRACKER_H
+
+#include <vector>
+#include <cstdint>
+
+#include "base/base.h"
+#include "dram_controller/impl/plugin/hash_index/hash_index.h"
+
+namespace Ramulator {
+
+/**
+ * @brief   A set of Space-Saving (Misra-Gries with spillover) frequent-item tables, e.g., one per bank.
+ * @details
+ * Each table tracks up to num_entries keys with their estimated counts, plus a spillover counter that is a lower
+ * bound of every tracked count. When a new key arrives at a full table, it replaces a tracked key whose count equals
+ * the spillover counter (and starts from spillover + 1), or, if there is none, increments the spillover counter.
+ *
+ * Entries are kept in a stream-summary: buckets of equal counts in a list sorted by count, so increments and
+ * finding the minimum are O(1), and a HashIndex maps keys to their entries. reset() only bumps a tracker-wide epoch;
+ * a table from an older epoch reads as empty and is cleared on its next increment.
+ */
+class FrequentItemTracker {
+public:
+    void init(int num_tables, int num_entries);
+
+    /**
+     * @brief   Clears all tables and spillover counters.
+     */
+    void reset();
+
+    /**
+     * @brief   Records an occurrence of key. Returns the new count, or -1 if key was not admitted to the table.
+     */
+    int increment(int table_id, int key);
+
+    /**
+     * @brief   Lowers the count of a tracked key to the spillover counter of its table.
+     */
+    void reset_to_spillover(int table_id, int key);
+
+    /**
+     * @brief   Returns the count of key, or -1 if it is not tracked.
+     */
+    int get_count(int table_id, int key) const;
+    bool contains(int table_id, int key) const { return get_count(table_id, key) != -1; };
+
+    int get_spillover(int table_id) const;
+    int get_size(int table_id) const;
+
+    /**
+     * @brief   Calls func(key, count) for every tracked key of the table.
+     */
+    template <typename Func_t>
+    void for_each(int table_id, Func_t&& func) const {
+        if (m_tables[table_id].epoch != m_epoch) {
+            return;
+        }
+        for (int e = 0; e < m_tables[table_id].size; e++) {
+            const Entry& entry = m_entries[table_id * m_num_entries + e];
+            func(entry.key, m_buckets[table_id * m_num_entries + entry.bucket].count);
+        }
+    };
+
+private:
+    struct Table {
+        uint32_t epoch = 0;
+        int size = 0;             // Number of tracked keys
+        int spillover = 0;
+        int min_bucket = -1;      // Head of the bucket list
+        int num_buckets = 0;      // Buckets ever allocated in this epoch
+        int free_bucket = -1;     // Head of the free bucket list
+    };
+
+    // Entry and bucket indices are local to their table, -1 means none
+    struct Entry {
+        int key;
+        int bucket;
+        int prev;
+        int next;
+    };
+
+    struct Bucket {
+        int count;
+        int head;                 // Oldest entry, the one evicted first
+        int tail;
+        int prev;
+        int next;
+    };
+
+    int m_num_tables = 0;
+    int m_num_entries = 0;
+    uint32_t m_epoch = 1;
+
+    std::vector<Table> m_tables;
+    std::vector<Entry> m_entries;    // [table][entry]
+    std::vector<Bucket> m_buckets;   // [table][bucket]
+    HashIndex m_index;
+
+    Table& get_table(int table_id);
+
+    int find_entry(int table_id, int key) const;
+
+    int alloc_bucket(int table_id, int count, int prev, int next);
+    int find_or_create_bucket(int table_id, int count, int from_bucket);
+    void attach(int table_id, int entry, int bucket);
+    void detach(int table_id, int entry);
+};
+
+}       // namespace Ramulator
+
+#endif  // RAMULATOR_PLUGUTIL_FREQUENTITEMTRACKER_H
@@ -1,11 +1,12 @@
 #include <vector>
-#include <unordered_map>
 #include <limits>
 #include <random>
 
 #include "base/base.h"
 #include "dram_controller/controller.h"
 #include "dram_controller/plugin.h"
+#include "dram_controller/impl/plugin/frequent_item_tracker/frequent_item_tracker.h"
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
 
 namespace Ramulator {
 
@@ -15,8 +16,6 @@ class Graphene : public IControllerPlugin, public Implementation {
   private:
     IDRAM* m_dram = nullptr;
 
-    int m_clk = -1;
-
     int m_num_table_entries = -1;
     int m_activation_threshold = -1;
     int m_reset_period_ns = -1;
@@ -33,13 +32,13 @@ class Graphene : public IControllerPlugin, public Implementation {
     int m_num_banks_per_rank = -1;
     int m_num_rows_per_bank = -1;
 
-    // per bank activation count table
+    // per bank activation count table with its spillover counter
     // indexed using flattened <rank id, bank id>
     // e.g., if rank 0, bank 4, index is 4
     // if rank 1, bank 5, index is 16 (assuming 16 banks/rank) + 5
-    std::vector<std::unordered_map<int, int>> m_activation_count_table;
-    // spillover counter per bank
-    std::vector<int> m_spillover_counter;
+    FrequentItemTracker m_activation_count_table;
+
+    MitigationStats m_mitigation;
 
 
   public:
@@ -48,6 +47,11 @@ class Graphene : public IControllerPlugin, public Implementation {
       m_activation_threshold = param<int>("activation_threshold").required();
       m_reset_period_ns = param<int>("reset_period_ns").required();
       m_is_debug = param<bool>("debug").default_val(false);
+
+      subscribe_commands(OpeningCommands);
+
+      m_mitigation.register_stats(this);
+      m_mitigation_stats = &m_mitigation;
     };
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
@@ -59,6 +63,11 @@ class Graphene : public IControllerPlugin, public Implementation {
       }
 
       m_reset_period_clk = m_reset_period_ns / ((float) m_dram->m_timing_vals("tCK_ps") / 1000.0f);
+      // Reset on controller cycles 1, P + 1, 2P + 1, ... as when Graphene counted its own cycles from -1
+      subscribe_timer(m_reset_period_clk, [this]() {
+        // Reset
+        m_activation_count_table.reset();
+      }, 1);
 
       m_VRR_req_id = m_dram->m_requests("victim-row-refresh");
 
@@ -72,32 +81,11 @@ class Graphene : public IControllerPlugin, public Implementation {
                              m_dram->get_level_size("bankgroup") * m_dram->get_level_size("bank");
       m_num_rows_per_bank = m_dram->get_level_size("row");
 
-      // Initialize bank act count tables
-      for (int i = 0; i < m_num_banks_per_rank * m_num_ranks; i++) {
-        std::unordered_map<int, int> table;
-        for (int j = -m_num_rows_per_bank; j < -m_num_rows_per_bank + m_num_table_entries; j++) {
-          table.insert(std::make_pair(j, 0));
-        }
-        m_activation_count_table.push_back(table);
-      }
-
-      // Initialize spillover counter
-      m_spillover_counter = std::vector<int>(m_num_banks_per_rank * m_num_ranks, 0);
+      // Initialize bank act count tables and spillover counters
+      m_activation_count_table.init(m_num_banks_per_rank * m_num_ranks, m_num_table_entries);
     };
 
     void update(bool request_found, ReqBuffer::iterator& req_it) override {
-      // Tick myself
-      m_clk++;
-
-      if (m_clk % m_reset_period_clk == 0) {
-        // Reset
-        for (int i = 0; i < m_num_banks_per_rank * m_num_ranks; i++) {
-          for (auto it = m_activation_count_table[i].begin(); it != m_activation_count_table[i].end(); it++)
-            it->second = 0;
-          m_spillover_counter[i] = 0;
-        }
-      }
-
       if (request_found) {
         if (m_dram->m_command_meta(req_it->command).is_opening && m_dram->m_command_scopes(req_it->command) == m_row_level) {
           int flat_bank_id = req_it->addr_vec[m_bank_level];
@@ -117,64 +105,28 @@ class Graphene : public IControllerPlugin, public Implementation {
             std::cout << "  └  " << "index: " << flat_bank_id << std::endl;
           }
 
-          if (m_activation_count_table[flat_bank_id].find(row_id) == m_activation_count_table[flat_bank_id].end()) {
-            // if row is not in the table, find an entry 
-            // with a count equal to that of the spillover counter
-            bool found = false;
-            int to_remove = -1;
-            int spillover_value = -1;
-
-            for (auto it = m_activation_count_table[flat_bank_id].begin(); it != m_activation_count_table[flat_bank_id].end(); it++) {
-              if (m_is_debug)
-                std::cout << "  └  " << "checking row " << it->first << " with count " << it->second << std::endl;
-
-              if (it->second == m_spillover_counter[flat_bank_id]) {
-                // if we find an entry, record it
-                spillover_value = it->second;
-                to_remove = it->first;
-                found = true;
-                break;
-              }
-            }
-            if (found) {
-              // for debug
-              if (m_is_debug) {
-                // print the row that is being removed
-                std::cout << "Removing row " << to_remove << " from table " << flat_bank_id << std::endl;
-                // print the row that is being added
-                std::cout << "Adding row " << row_id << " to table " << flat_bank_id << std::endl;
-                std::cout << "  └  " << "spillover counter: " << m_spillover_counter[flat_bank_id] << std::endl;
-              }
-              // remove to_remove from the table
-              m_activation_count_table[flat_bank_id].erase(to_remove);
-              // add row_id to the table
-              m_activation_count_table[flat_bank_id][row_id] = spillover_value + 1;
-            }
-            // if we did not find such an entry, increment spillover counter by one
-            else {
-              m_spillover_counter[flat_bank_id] += 1;
-            }
+          // If the row is not in the table, it replaces an entry with a count equal to that of the spillover counter,
+          // or, if there is no such entry, the spillover counter is incremented by one
+          bool is_tracked = m_activation_count_table.contains(flat_bank_id, row_id);
+          int count = m_activation_count_table.increment(flat_bank_id, row_id);
+
+          if (m_is_debug) {
+            std::cout << "Row " << row_id << " in table[" << flat_bank_id << "]" << std::endl;
+            std::cout << "  └  " << "threshold: " << m_activation_threshold << std::endl;
+            std::cout << "  └  " << "count: " << count << std::endl;
+            std::cout << "  └  " << "spillover counter: " << m_activation_count_table.get_spillover(flat_bank_id) << std::endl;
           }
-          else {
-            // if row in table, increment its activation count
-            m_activation_count_table[flat_bank_id][row_id] += 1;
-            
-            if (m_is_debug) {
-              std::cout << "Row " << row_id << " in table[" << flat_bank_id << "]" << std::endl;
-              std::cout << "  └  " << "threshold: " << m_activation_threshold << std::endl;
-              std::cout << "  └  " << "count: " << m_activation_count_table[flat_bank_id][row_id] << std::endl;
-            }
 
-            // check if the count exceeds the threshold
-            if (m_activation_count_table[flat_bank_id][row_id] >= m_activation_threshold) {
-              if (m_is_debug) {
-                std::cout << "Row " << row_id << " in table " << flat_bank_id << " has exceeded the threshold!" << std::endl;
-              }
-              // if yes, schedule preventive refreshes
-              Request vrr_req(req_it->addr_vec, m_VRR_req_id);
-              m_ctrl->priority_send(vrr_req);
-              m_activation_count_table[flat_bank_id][row_id] = m_spillover_counter[flat_bank_id];
+          // check if the count of a row that was already in the table exceeds the threshold
+          if (is_tracked && count >= m_activation_threshold) {
+            if (m_is_debug) {
+              std::cout << "Row " << row_id << " in table " << flat_bank_id << " has exceeded the threshold!" << std::endl;
             }
+            // if yes, schedule preventive refreshes
+            Request vrr_req(req_it->addr_vec, m_VRR_req_id);
+            m_mitigation.tag(vrr_req);
+            m_ctrl->priority_send(vrr_req);
+            m_activation_count_table.reset_to_spillover(flat_bank_id, row_id);
           }
         }
       }
@@ -0,0 +1,60 @@
+#include "dram_controller/impl/plugin/hash_index/hash_index.h"
+
+namespace Ramulator {
+
+void HashIndex::init(int num_tables, int capacity) {
+    m_slot_bits = 1;
+    while ((1 << m_slot_bits) < 2 * capacity) {
+        m_slot_bits++;
+    }
+
+    m_epochs.assign(num_tables, 1);
+    m_slots.assign((size_t) num_tables << m_slot_bits, {-1, -1, 0});
+}
+
+int HashIndex::find_slot(int table_id, int key) const {
+    const Slot* slots = get_slots(table_id);
+    uint32_t epoch = m_epochs[table_id];
+    int mask = (1 << m_slot_bits) - 1;
+    for (int i = home_slot(key); ; i = (i + 1) & mask) {
+        if (slots[i].epoch != epoch) {
+            return -1;
+        }
+        if (slots[i].key == key) {
+            return i;
+        }
+    }
+}
+
+void HashIndex::insert(int table_id, int key, int entry) {
+    Slot* slots = get_slots(table_id);
+    uint32_t epoch = m_epochs[table_id];
+    int mask = (1 << m_slot_bits) - 1;
+    int i = home_slot(key);
+    while (slots[i].epoch == epoch) {
+        i = (i + 1) & mask;
+    }
+    slots[i] = {key, entry, epoch};
+}
+
+void HashIndex::erase(int table_id, int key) {
+    int hole = find_slot(table_id, key);
+    if (hole == -1) {
+        return;
+    }
+    Slot* slots = get_slots(table_id);
+    uint32_t epoch = m_epochs[table_id];
+    int mask = (1 << m_slot_bits) - 1;
+    // Move back every later key of the probe run whose home slot does not lie between the hole and itself
+    for (int j = (hole + 1) & mask; slots[j].epoch == epoch; j = (j + 1) & mask) {
+        int home = home_slot(slots[j].key);
+        bool movable = (hole <= j) ? (home <= hole || home > j) : (home <= hole && home > j);
+        if (movable) {
+            slots[hole] = slots[j];
+            hole = j;
+        }
+    }
+    slots[hole].epoch = 0;
+}
+
+}   // namespace Ramulator
@@ -0,0 +1,75 @@
+#ifndef RAMULATOR_PLUGUTIL_HASHINDEX_H
+#define RAMULATOR_PLUGUTIL_HASHINDEX_H
+
+#include <vector>
+#include <cstdint>
+
+#include "base/base.h"
+
+namespace Ramulator {
+
+/**
+ * @brief   A set of fixed-size key -> entry index hash tables, e.g., one per bank.
+ * @details
+ * Open addressing with linear probing over one flat slot array. Every slot is tagged with the epoch of its table, so
+ * clear() only bumps that epoch. Erasing uses backward-shift deletion, so no tombstones are left behind.
+ */
+class HashIndex {
+public:
+    /**
+     * @brief   Sizes each table to hold up to capacity keys at a load factor of at most one half.
+     */
+    void init(int num_tables, int capacity);
+
+    /**
+     * @brief   Removes all keys of the table.
+     */
+    void clear(int table_id) { m_epochs[table_id]++; };
+
+    /**
+     * @brief   Returns the entry of key, or -1 if it is not in the table.
+     */
+    int find(int table_id, int key) const {
+        int slot = find_slot(table_id, key);
+        return slot == -1 ? -1 : get_slots(table_id)[slot].entry;
+    };
+
+    /**
+     * @brief   Inserts key (which must not be in the table and must fit in its capacity).
+     */
+    void insert(int table_id, int key, int entry);
+
+    /**
+     * @brief   Points key (which must be in the table) to another entry.
+     */
+    void update(int table_id, int key, int entry) { get_slots(table_id)[find_slot(table_id, key)].entry = entry; };
+
+    /**
+     * @brief   Erases key, if it is in the table.
+     */
+    void erase(int table_id, int key);
+
+private:
+    struct Slot {
+        int key;
+        int entry;
+        uint32_t epoch;           // The slot is empty unless it matches the epoch of its table
+    };
+
+    int m_slot_bits = 0;
+    std::vector<uint32_t> m_epochs;  // [table]
+    std::vector<Slot> m_slots;       // [table][slot]
+
+    Slot* get_slots(int table_id) { return &m_slots[(size_t) table_id << m_slot_bits]; };
+    const Slot* get_slots(int table_id) const { return &m_slots[(size_t) table_id << m_slot_bits]; };
+
+    int home_slot(int key) const {
+        return (uint32_t(key) * 2654435761u) >> (32 - m_slot_bits);
+    };
+
+    int find_slot(int table_id, int key) const;
+};
+
+}       // namespace Ramulator
+
+#endif  // RAMULATOR_PLUGUTIL_HASHINDEX_H
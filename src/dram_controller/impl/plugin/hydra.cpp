@@ -1,9 +1,8 @@
 #include <vector>
-#include <unordered_map>
 #include <limits>
 #include <bitset>
 #include <iomanip>
-#include <random>
+#include <algorithm>
 
 #include "base/base.h"
 #include "frontend/frontend.h"
@@ -11,6 +10,7 @@
 #include "addr_mapper/addr_mapper.h"
 #include "dram_controller/controller.h"
 #include "dram_controller/plugin.h"
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
 
 namespace Ramulator {
 
@@ -22,12 +22,13 @@ class Hydra : public IControllerPlugin, public Implementation {
     ITranslation* m_translation = nullptr;
     IAddrMapper* m_addr_mapper = nullptr;
 
-    struct GCT_Entry {
-      int group_count;
-      bool initialized;
-    };
+    // All counters are 16-bit and saturate, like the hardware tables they model
+    using Counter_t = uint16_t;
+    static constexpr int m_counter_max = std::numeric_limits<Counter_t>::max();
 
-    int m_clk = -1;
+    enum class RCCPolicy {
+      RANDOM, MIN_COUNT, LRU
+    };
 
     // input parameters
     int m_tracking_threshold = -1;
@@ -35,7 +36,9 @@ class Hydra : public IControllerPlugin, public Implementation {
     int m_row_group_size = -1;
     int m_reset_period_ns = -1;
     int m_rcc_num_per_rank = -1;
+    int m_rcc_num_ways = -1;
     std::string m_rcc_policy = "RANDOM";
+    RCCPolicy m_rcc_policy_id = RCCPolicy::RANDOM;
 
     int m_reset_period_clk = -1;
 
@@ -70,34 +73,27 @@ class Hydra : public IControllerPlugin, public Implementation {
     int m_rct_per_cl = -1;
     int m_group_rct_cl_size = -1;
 
-    // per bank GCT, 
-    // the first index is the flat bank id
-    // the second index is the row group id
+    // per bank GCT, flattened as [flat bank id][row group id]
     // each entry has a group counter and a flag indicating if the group counter has beed initialized
     // the row group id uses the most significant bits of the row id
-    std::vector<std::unordered_map<Addr_t, GCT_Entry>> group_count_table;
-    // per bank RCT,
-    // the first index is the flat bank id
-    // the second index is the row id
+    std::vector<Counter_t> m_gct_counts;
+    std::vector<uint8_t> m_gct_initialized;
+    // per bank RCT, flattened as [flat bank id][row id]
     // each entry has a row counter
-    std::vector<std::unordered_map<Addr_t, int>> row_count_table;
-    // per rank RCC,
-    // a 16-set associative cache
-    // the first index is the rank id
-    // the second index is the rcc set id
-    // each entry has an rcc tag and a row counter
+    std::vector<Counter_t> m_rct_counts;
+    // per rank RCC, a set associative cache flattened as [rank id][rcc set id][way]
+    // each way has an rcc tag (-1 if invalid), a row counter, and the cycle of its last use (for LRU)
     // the rcc set id uses the least significant bits of the row id
     // the rcc tag uses the most significant bits of the row id and the bank id
-    std::vector<std::vector<std::unordered_map<Addr_t, int>>> row_count_cache;
-    // per bank RCT count table,
-    // the first index is the flat bank id
-    // the second index is the row id
+    std::vector<int> m_rcc_tags;
+    std::vector<Counter_t> m_rcc_counts;
+    std::vector<int64_t> m_rcc_last_use;
+    // per bank RCT count table, flattened as [flat bank id][row id], only for the rows that store the RCT
     // each entry has a row counter
-    std::vector<std::unordered_map<Addr_t, int>> rct_count_table;
+    std::vector<Counter_t> m_rctct_counts;
 
     // rng for random policy
-    std::mt19937 generator;
-    std::uniform_int_distribution<int> distribution;
+    RandomStream m_rng;
 
     // stats
     int s_num_vrr = 0;
@@ -111,18 +107,44 @@ class Hydra : public IControllerPlugin, public Implementation {
     int s_rcc_check = 0;
     int s_rct_check = 0;
     int s_rctct_check = 0;
+    size_t s_table_bytes = 0;
 
     bool m_is_debug;
 
+    MitigationStats m_mitigation;
+
   public:
-    void init() override { 
+    void init() override {
       m_tracking_threshold = param<int>("hydra_tracking_threshold").required();
       m_group_threshold = param<int>("hydra_group_threshold").required();
       m_row_group_size = param<int>("hydra_row_group_size").default_val(128);
       m_reset_period_ns = param<int>("hydra_reset_period_ns").default_val(64000000);
       m_rcc_num_per_rank = param<int>("hydra_rcc_num_per_rank").default_val(4096);
-      m_rcc_policy = param<std::string>("hydra_rcc_policy").default_val("RANDOM");
+      m_rcc_num_ways = param<int>("hydra_rcc_num_ways").desc("Associativity of the row count cache.").default_val(16);
+      m_rcc_policy = param<std::string>("hydra_rcc_policy").desc("Replacement policy of the row count cache (RANDOM, MIN_COUNT or LRU).").default_val("RANDOM");
       m_is_debug = param<bool>("debug").default_val(false);
+
+      subscribe_commands(OpeningCommands);
+
+      m_mitigation.register_stats(this);
+      m_mitigation_stats = &m_mitigation;
+
+      if (m_rcc_policy == "RANDOM") {
+        m_rcc_policy_id = RCCPolicy::RANDOM;
+      } else if (m_rcc_policy == "MIN_COUNT") {
+        m_rcc_policy_id = RCCPolicy::MIN_COUNT;
+      } else if (m_rcc_policy == "LRU") {
+        m_rcc_policy_id = RCCPolicy::LRU;
+      } else {
+        throw ConfigurationError("Undefined RCC eviction policy \"{}\" for Hydra!", m_rcc_policy);
+      }
+
+      if (m_tracking_threshold > m_counter_max || m_group_threshold > m_counter_max) {
+        throw ConfigurationError("Hydra thresholds must fit in its {}-bit counters!", std::numeric_limits<Counter_t>::digits);
+      }
+      if (m_rcc_num_ways <= 0 || m_rcc_num_per_rank % m_rcc_num_ways != 0) {
+        throw ConfigurationError("Hydra RCC size ({}) must be a multiple of its associativity ({})!", m_rcc_num_per_rank, m_rcc_num_ways);
+      }
     };
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
@@ -137,6 +159,14 @@ class Hydra : public IControllerPlugin, public Implementation {
       }
 
       m_reset_period_clk = m_reset_period_ns / ((float) m_dram->m_timing_vals("tCK_ps") / 1000.0f);
+      // Reset on controller cycles 1, P + 1, 2P + 1, ... as when Hydra counted its own cycles from -1
+      subscribe_timer(m_reset_period_clk, [this]() {
+        reset_tables();
+        if (m_is_debug) {
+          std::cout << "----------------------------------" << std::endl;
+          std::cout << "Hydra: Reset all tables (" << m_ctrl->get_clk() << ")" << std::endl;
+        }
+      }, 1);
 
       m_VRR_req_id = m_dram->m_requests("victim-row-refresh");
       m_RD_req_id = m_dram->m_requests("read");
@@ -149,8 +179,8 @@ class Hydra : public IControllerPlugin, public Implementation {
       m_col_level = m_dram->m_levels("column");
 
       m_num_ranks = m_dram->get_level_size("rank");
-      m_num_banks_per_rank = m_dram->get_level_size("bankgroup") == -1 ? 
-                             m_dram->get_level_size("bank") : 
+      m_num_banks_per_rank = m_dram->get_level_size("bankgroup") == -1 ?
+                             m_dram->get_level_size("bank") :
                              m_dram->get_level_size("bankgroup") * m_dram->get_level_size("bank");
       m_num_rows_per_bank = m_dram->get_level_size("row");
       m_num_cls = m_dram->get_level_size("column") / 8;
@@ -160,7 +190,7 @@ class Hydra : public IControllerPlugin, public Implementation {
       m_counter_bits = ceil(log2(m_tracking_threshold) / 8) * 8;
       m_gct_entries_per_bank = m_num_rows_per_bank / m_row_group_size;
       m_gct_index_bits = log2(m_gct_entries_per_bank);
-      m_rcc_set_num = m_rcc_num_per_rank / 16;
+      m_rcc_set_num = m_rcc_num_per_rank / m_rcc_num_ways;
       m_rcc_index_bits = log2(m_rcc_set_num);
       m_rcc_tag_row_bits = m_row_address_bits - m_rcc_index_bits;
       m_rcc_tag_bits = m_rcc_tag_row_bits + m_bank_address_bits;
@@ -177,30 +207,20 @@ class Hydra : public IControllerPlugin, public Implementation {
       m_group_rct_cl_size = m_row_group_size * m_counter_bits / 512;
 
       // Initialize tables
-      for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-        std::unordered_map<Addr_t, GCT_Entry> gct_bank;
-        group_count_table.push_back(gct_bank);
-      }
-
-      for (int i = 0; i < m_num_ranks; i++) {
-        std::vector<std::unordered_map<Addr_t, int>> rcc_rank;
-        for (int j = 0 ; j < m_rcc_set_num; j++){
-          std::unordered_map<Addr_t, int> rcc_set;
-          rcc_rank.push_back(rcc_set);
-        }
-        row_count_cache.push_back(rcc_rank);
-      }
-      
-      for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-        std::unordered_map<Addr_t, int> row_count_table_bank;
-        row_count_table.push_back(row_count_table_bank);
-      }
-
-      rct_count_table.resize(m_num_ranks * m_num_banks_per_rank);
-      for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-        std::unordered_map<Addr_t, int> rctct_bank;
-        rct_count_table.push_back(rctct_bank);
-      }
+      size_t num_banks = m_num_ranks * m_num_banks_per_rank;
+      m_gct_counts.resize(num_banks * m_gct_entries_per_bank);
+      m_gct_initialized.resize(num_banks * m_gct_entries_per_bank);
+      m_rct_counts.resize(num_banks * m_num_rows_per_bank);
+      m_rcc_tags.resize((size_t) m_num_ranks * m_rcc_num_per_rank);
+      m_rcc_counts.resize((size_t) m_num_ranks * m_rcc_num_per_rank);
+      m_rcc_last_use.resize((size_t) m_num_ranks * m_rcc_num_per_rank);
+      m_rctct_counts.resize(num_banks * m_total_rct_row_size);
+      reset_tables();
+
+      s_table_bytes = m_gct_counts.size() * sizeof(Counter_t) + m_gct_initialized.size() * sizeof(uint8_t) +
+                      m_rct_counts.size() * sizeof(Counter_t) +
+                      m_rcc_tags.size() * sizeof(int) + m_rcc_counts.size() * sizeof(Counter_t) + m_rcc_last_use.size() * sizeof(int64_t) +
+                      m_rctct_counts.size() * sizeof(Counter_t);
 
       if (m_is_debug) {
         std::cout << "------------------------------------" << std::endl
@@ -214,6 +234,7 @@ class Hydra : public IControllerPlugin, public Implementation {
         std::cout << "m_row_group_size:           " << m_row_group_size << std::endl;
         std::cout << "m_reset_period_ns:          " << m_reset_period_ns << std::endl;
         std::cout << "m_rcc_num_per_rank:         " << m_rcc_num_per_rank << std::endl;
+        std::cout << "m_rcc_num_ways:             " << m_rcc_num_ways << std::endl;
         std::cout << "m_rcc_policy:               " << m_rcc_policy << std::endl;
 
         std::cout << "m_row_address_bits:         " << m_row_address_bits << std::endl;
@@ -230,6 +251,7 @@ class Hydra : public IControllerPlugin, public Implementation {
         std::cout << "m_rct_per_row:              " << m_rct_per_row << std::endl;
         std::cout << "m_rct_per_cl:               " << m_rct_per_cl << std::endl;
         std::cout << "m_group_rct_cl_size:        " << m_group_rct_cl_size << std::endl;
+        std::cout << "table_bytes:                " << s_table_bytes << std::endl;
       }
 
       reserve_rows_for_rct();
@@ -245,36 +267,13 @@ class Hydra : public IControllerPlugin, public Implementation {
       register_stat(s_rcc_check).name("hydra_rcc_check");
       register_stat(s_rct_check).name("hydra_rct_check");
       register_stat(s_rctct_check).name("hydra_rctct_check");
+      register_stat(s_table_bytes).name("hydra_table_bytes").desc("Simulator memory used by the GCT, RCT, RCC and RCT count tables");
 
       // setup random number generator for random policy
-      generator = std::mt19937(1337);
-      distribution = std::uniform_int_distribution<int>(0, 15);
+      m_rng = create_rng_stream();
     };
 
     void update(bool request_found, ReqBuffer::iterator& req_it) override {
-
-      m_clk++;
-      if (m_clk % m_reset_period_clk == 0) {
-        for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-          group_count_table[i].clear();
-        }
-        for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-          row_count_table[i].clear();
-        }
-        for (int i = 0; i < m_num_ranks; i++) {
-          for (int j = 0 ; j < m_rcc_set_num; j++){
-            row_count_cache[i][j].clear();
-          }
-        }
-        for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-          rct_count_table[i].clear();
-        }
-        if (m_is_debug) {
-          std::cout << "----------------------------------" << std::endl;
-          std::cout << "Hydra: Reset all tables (" << m_clk << ")" << std::endl;
-        }
-      }
-
       if (request_found){
         if (m_dram->m_command_meta(req_it->command).is_opening && m_dram->m_command_scopes(req_it->command) == m_row_level){
           int flat_bank_id = req_it->addr_vec[m_bank_level];
@@ -283,18 +282,18 @@ class Hydra : public IControllerPlugin, public Implementation {
             accumulated_dimension *= m_dram->m_organization.count[i + 1];
             flat_bank_id += req_it->addr_vec[i] * accumulated_dimension;
           }
-          
+
           uint rank_id = req_it->addr_vec[m_rank_level];
           uint bank_id = flat_bank_id % m_num_banks_per_rank;
           uint row_id = req_it->addr_vec[m_row_level];
           uint gct_index = row_id >> (m_row_address_bits - m_gct_index_bits); // get most significant bits
           uint rcc_index = row_id & ((1 << m_rcc_index_bits) - 1); // get least significant bits
-          uint rcc_tag = row_id >> (m_row_address_bits - m_rcc_tag_row_bits) // most significant bits of row_id 
+          uint rcc_tag = row_id >> (m_row_address_bits - m_rcc_tag_row_bits) // most significant bits of row_id
                           | bank_id << m_rcc_tag_row_bits; // bank_id
 
           if (m_is_debug) {
             std::cout << "----------------------------------" << std::endl
-                      << "Hydra: Activation cmd (" << m_clk << ") " << flat_bank_id << "," << gct_index << "," << row_id << std::endl
+                      << "Hydra: Activation cmd (" << m_ctrl->get_clk() << ") " << flat_bank_id << "," << gct_index << "," << row_id << std::endl
                       << "        flat_bank_id: " << std::setw(6) << flat_bank_id << " - " << std::bitset<5>(flat_bank_id) << std::endl
                       << "        rank_id:      " << std::setw(6) << rank_id      << " - " << std::bitset<1>(rank_id) << std::endl
                       << "        bank_id:      " << std::setw(6) << bank_id      << " -  " << std::bitset<4>(bank_id) << std::endl
@@ -307,27 +306,26 @@ class Hydra : public IControllerPlugin, public Implementation {
           // if the row is in the RCT rows, use RCT_count_table
           if (row_id < m_total_rct_row_size){
             // increment RCT_count_table
-            if (rct_count_table[flat_bank_id].find(row_id) == rct_count_table[flat_bank_id].end()){
-              rct_count_table[flat_bank_id][row_id] = 0;
-            }
-            rct_count_table[flat_bank_id][row_id]++;
+            Counter_t& rctct_count = m_rctct_counts[(size_t) flat_bank_id * m_total_rct_row_size + row_id];
+            increment(rctct_count);
             if (m_is_debug) {
               std::cout << "Hydra: Row in RCT rows" << std::endl;
-              std::cout << "Hydra: RCT_count_table incremented (" << rct_count_table[flat_bank_id][row_id] << ")" << std::endl;
+              std::cout << "Hydra: RCT_count_table incremented (" << rctct_count << ")" << std::endl;
             }
             // check rct_count_table
             s_rctct_check++;
-            if (rct_count_table[flat_bank_id][row_id] >= m_tracking_threshold){
+            if (rctct_count >= m_tracking_threshold){
               if (m_is_debug) {
                 std::cout << "Hydra: RCT_count_table above threshold, issue VRR, reset counter" << std::endl;
               }
               // issue VRR
               Request vrr_req(req_it->addr_vec, m_VRR_req_id);
+              m_mitigation.tag(vrr_req);
               m_ctrl->priority_send(vrr_req);
               s_num_vrr_rct++;
               s_num_vrr++;
               // reset rcc
-              rct_count_table[flat_bank_id].erase(row_id);
+              rctct_count = 0;
             } else {
               if (m_is_debug) {
                 std::cout << "Hydra: RCT_count_table below threshold, do nothing" << std::endl;
@@ -339,46 +337,36 @@ class Hydra : public IControllerPlugin, public Implementation {
           // check gct
           s_gct_check++;
 
-          if (group_count_table[flat_bank_id].find(gct_index) == group_count_table[flat_bank_id].end()) {
-            GCT_Entry new_group_entry;
-            new_group_entry.group_count = 0;
-            new_group_entry.initialized = false;
-            group_count_table[flat_bank_id][gct_index] = new_group_entry;
-          }
-
-          if (group_count_table[flat_bank_id][gct_index].group_count >= m_group_threshold){
+          size_t gct_entry = (size_t) flat_bank_id * m_gct_entries_per_bank + gct_index;
+          if (m_gct_counts[gct_entry] >= m_group_threshold){
             if (m_is_debug) {
               std::cout << "Hydra: Checking GCT" << std::endl;
-              std::cout << "Hydra: GCT above threshold " 
-                        << group_count_table[flat_bank_id][gct_index].group_count << std::endl;
+              std::cout << "Hydra: GCT above threshold "
+                        << m_gct_counts[gct_entry] << std::endl;
             }
 
-            if (!group_count_table[flat_bank_id][gct_index].initialized){
+            if (!m_gct_initialized[gct_entry]){
               if (m_is_debug) {
                 std::cout << "Hydra: Group not initialized" << std::endl;
               }
 
               // initialize rct
-              group_count_table[flat_bank_id][gct_index].initialized = true;
+              m_gct_initialized[gct_entry] = true;
               s_num_initialization++;
               int row_group_start_row_id = gct_index * m_row_group_size;
-              for (int i = 0; i < m_row_group_size; i++){
-                int row = row_group_start_row_id + i;
-                row_count_table[flat_bank_id][row] = m_group_threshold;
-              }
+              Counter_t* group_rct = &m_rct_counts[(size_t) flat_bank_id * m_num_rows_per_bank + row_group_start_row_id];
+              std::fill(group_rct, group_rct + m_row_group_size, m_group_threshold);
               // generate write request to DRAM for rct
               for (int i = 0; i < m_group_rct_cl_size; i++){
-                std::vector<int> rct_init_addr_vec;
-                for (int j = 0; j < req_it->addr_vec.size(); j++){
-                  rct_init_addr_vec.push_back(req_it->addr_vec[j]);
-                }
+                AddrVec_t rct_init_addr_vec = req_it->addr_vec;
                 std::pair<Addr_t, Addr_t> init_row_col_id = generate_row_col_id(row_group_start_row_id + i * m_rct_per_cl);
                 rct_init_addr_vec[m_row_level] = init_row_col_id.first;
                 rct_init_addr_vec[m_col_level] = init_row_col_id.second;
                 Request rct_init_req(rct_init_addr_vec, m_WR_req_id);
+                m_mitigation.tag(rct_init_req);
                 m_ctrl->priority_send(rct_init_req);
                 s_num_write_req++;
-                
+
                 if (m_is_debug) {
                   std::cout << "Hydra: Group initializing, generating write request to DRAM for RCT" << std::endl
                             << "        rct_bank: " << flat_bank_id << std::endl
@@ -392,33 +380,39 @@ class Hydra : public IControllerPlugin, public Implementation {
               }
             }
 
+            size_t rcc_set = ((size_t) rank_id * m_rcc_set_num + rcc_index) * m_rcc_num_ways;
+            int* set_tags = &m_rcc_tags[rcc_set];
+            Counter_t* set_counts = &m_rcc_counts[rcc_set];
+
             if (m_is_debug) {
-              std::cout << "Hydra: Checking RCC[" << rank_id << "][" << rcc_index << "].size() = " << row_count_cache[rank_id][rcc_index].size() << std::endl;
-              for (auto it = row_count_cache[rank_id][rcc_index].begin(); it != row_count_cache[rank_id][rcc_index].end(); it++){
-                std::cout << "        tag: " << std::setw(6) << it->first << " counter: " << it->second << std::endl;
+              std::cout << "Hydra: Checking RCC[" << rank_id << "][" << rcc_index << "]" << std::endl;
+              for (int way = 0; way < m_rcc_num_ways; way++){
+                if (set_tags[way] != -1) {
+                  std::cout << "        tag: " << std::setw(6) << set_tags[way] << " counter: " << set_counts[way] << std::endl;
+                }
               }
             }
 
             // check rcc
             s_rcc_check++;
-            if (row_count_cache[rank_id][rcc_index].find(rcc_tag) == row_count_cache[rank_id][rcc_index].end()){
+            Counter_t& rct_count = m_rct_counts[(size_t) flat_bank_id * m_num_rows_per_bank + row_id];
+            int way = find_way(set_tags, rcc_tag);
+            if (way == -1){
               s_num_rcc_miss++;
               if (m_is_debug) {
                 std::cout << "Hydra: RCC miss" << std::endl;
               }
               // check if rcc line is full
-              if (row_count_cache[rank_id][rcc_index].size() == 16){
+              way = find_way(set_tags, -1);
+              if (way == -1){
                 // evicting an entry
-                int tag_to_evict = get_tag_to_evict(rank_id, rcc_index);
-                row_count_cache[rank_id][rcc_index].erase(tag_to_evict);
+                way = get_way_to_evict(rcc_set);
+                int tag_to_evict = set_tags[way];
                 if (m_is_debug) {
                   std::cout << "Hydra: RCC full, evicting " << tag_to_evict << std::endl;
                 }
                 // generate write request to DRAM for evicted entry
-                std::vector<int> evicted_entry_addr_vec;
-                for (int i = 0; i < req_it->addr_vec.size(); i++){
-                  evicted_entry_addr_vec.push_back(req_it->addr_vec[i]);
-                }
+                AddrVec_t evicted_entry_addr_vec = req_it->addr_vec;
                 int evicted_row_id = (tag_to_evict & ((1 << m_rcc_tag_row_bits) - 1)) << m_rcc_index_bits | rcc_index;
                 int evicted_bank_id = tag_to_evict >> m_rcc_tag_row_bits;
                 std::pair<Addr_t, Addr_t> evicted_row_col_id = generate_row_col_id(evicted_row_id);
@@ -427,6 +421,7 @@ class Hydra : public IControllerPlugin, public Implementation {
                 evicted_entry_addr_vec[m_row_level] = evicted_row_col_id.first;
                 evicted_entry_addr_vec[m_col_level] = evicted_row_col_id.second;
                 Request rct_write_req(evicted_entry_addr_vec, m_WR_req_id);
+                m_mitigation.tag(rct_write_req);
                 m_ctrl->priority_send(rct_write_req);
                 s_num_eviction++;
                 s_num_write_req++;
@@ -448,22 +443,21 @@ class Hydra : public IControllerPlugin, public Implementation {
               // read rct from DRAM and update rcc
               s_rct_check++;
               // copy addr_vec and update row_id
-              AddrVec_t rct_read_addr_vec;
-              for (int i = 0; i < req_it->addr_vec.size(); i++){
-                rct_read_addr_vec.push_back(req_it->addr_vec[i]);
-              }
+              AddrVec_t rct_read_addr_vec = req_it->addr_vec;
               std::pair<Addr_t, Addr_t> row_col_id = generate_row_col_id(rct_read_addr_vec[m_row_level]);
               rct_read_addr_vec[m_row_level] = row_col_id.first;
               rct_read_addr_vec[m_col_level] = row_col_id.second;
 
               Request rct_read_req(rct_read_addr_vec, m_RD_req_id);
+              m_mitigation.tag(rct_read_req);
               m_ctrl->priority_send(rct_read_req);
               s_num_read_req++;
 
               // insert new entry and increment rcc
-              row_count_table[flat_bank_id][row_id]++;
-              row_count_cache[rank_id][rcc_index][rcc_tag] = row_count_table[flat_bank_id][row_id];
-              
+              increment(rct_count);
+              set_tags[way] = rcc_tag;
+              set_counts[way] = rct_count;
+
               if (m_is_debug) {
                 std::cout << "Hydra: Generating read request to DRAM for RCT" << std::endl
                           << "        rct_bank: " << flat_bank_id << std::endl
@@ -472,30 +466,32 @@ class Hydra : public IControllerPlugin, public Implementation {
                 std::cout << "Hydra: RCC incrementing" << std::endl;
               }
             } else {
-              row_count_cache[rank_id][rcc_index][rcc_tag]++;
-              row_count_table[flat_bank_id][row_id]++;
+              increment(set_counts[way]);
+              increment(rct_count);
               if (m_is_debug) {
                 std::cout << "Hydra: RCC hit" << std::endl;
                 std::cout << "Hydra: RCC incrementing" << std::endl;
               }
             }
+            m_rcc_last_use[rcc_set + way] = m_ctrl->get_clk();
 
             if (m_is_debug) {
-              std::cout << "Hydra: Checking RCC counter (" << row_count_cache[rank_id][rcc_index][rcc_tag] << ")" << std::endl;
+              std::cout << "Hydra: Checking RCC counter (" << set_counts[way] << ")" << std::endl;
             }
 
             // check if counter is above threshold
-            if (row_count_cache[rank_id][rcc_index][rcc_tag] >= m_tracking_threshold){
+            if (set_counts[way] >= m_tracking_threshold){
               if (m_is_debug) {
                 std::cout << "Hydra: RCC above threshold, issue VRR, reset counter" << std::endl;
               }
               // issue VRR
               Request vrr_req(req_it->addr_vec, m_VRR_req_id);
+              m_mitigation.tag(vrr_req);
               m_ctrl->priority_send(vrr_req);
               s_num_vrr++;
               // reset rcc
-              row_count_cache[rank_id][rcc_index][rcc_tag] = 0;
-              row_count_table[flat_bank_id][row_id] = 0;
+              set_counts[way] = 0;
+              rct_count = 0;
             } else {
               if (m_is_debug) {
                 std::cout << "Hydra: RCC below threshold, do nothing" << std::endl;
@@ -505,10 +501,10 @@ class Hydra : public IControllerPlugin, public Implementation {
           else{
             if (m_is_debug) {
               std::cout << "Hydra: Checking GCT" << std::endl;
-              std::cout << "Hydra: GCT below threshold (" << group_count_table[flat_bank_id][gct_index].group_count << ")" << std::endl;
+              std::cout << "Hydra: GCT below threshold (" << m_gct_counts[gct_entry] << ")" << std::endl;
               std::cout << "Hydra: GCT incrementing" << std::endl;
             }
-            group_count_table[flat_bank_id][gct_index].group_count++;
+            increment(m_gct_counts[gct_entry]);
           }
         }
       }
@@ -521,27 +517,59 @@ class Hydra : public IControllerPlugin, public Implementation {
       return std::make_pair(rct_row_id, rct_col_id);
     };
 
-    int get_tag_to_evict(int rank_id, int rcc_index) {
-      int tag_to_evict = -1;
+    void increment(Counter_t& counter) {
+      if (counter < m_counter_max) {
+        counter++;
+      }
+    };
 
-      if (m_rcc_policy == "RANDOM") {
-        int tag_index = distribution(generator);
-        auto it = row_count_cache[rank_id][rcc_index].begin();
-        std::advance(it, tag_index);
-        tag_to_evict = it->first;
-      } else if (m_rcc_policy == "MIN_COUNT") {
-        int min_count = INT_MAX;
-        for (auto it = row_count_cache[rank_id][rcc_index].begin(); it != row_count_cache[rank_id][rcc_index].end(); it++) {
-          if (it->second < min_count) {
-            min_count = it->second;
-            tag_to_evict = it->first;
+    void reset_tables() {
+      std::fill(m_gct_counts.begin(), m_gct_counts.end(), 0);
+      std::fill(m_gct_initialized.begin(), m_gct_initialized.end(), false);
+      std::fill(m_rct_counts.begin(), m_rct_counts.end(), 0);
+      std::fill(m_rcc_tags.begin(), m_rcc_tags.end(), -1);
+      std::fill(m_rcc_counts.begin(), m_rcc_counts.end(), 0);
+      std::fill(m_rctct_counts.begin(), m_rctct_counts.end(), 0);
+    };
+
+    int find_way(const int* set_tags, int tag) {
+      for (int way = 0; way < m_rcc_num_ways; way++) {
+        if (set_tags[way] == tag) {
+          return way;
+        }
+      }
+      return -1;
+    };
+
+    int get_way_to_evict(size_t rcc_set) {
+      int way_to_evict = 0;
+
+      switch (m_rcc_policy_id) {
+        case RCCPolicy::RANDOM: {
+          way_to_evict = m_rng.uniform_int(0, m_rcc_num_ways - 1);
+          break;
+        }
+        case RCCPolicy::MIN_COUNT: {
+          const Counter_t* set_counts = &m_rcc_counts[rcc_set];
+          for (int way = 1; way < m_rcc_num_ways; way++) {
+            if (set_counts[way] < set_counts[way_to_evict]) {
+              way_to_evict = way;
+            }
           }
+          break;
+        }
+        case RCCPolicy::LRU: {
+          const int64_t* set_last_use = &m_rcc_last_use[rcc_set];
+          for (int way = 1; way < m_rcc_num_ways; way++) {
+            if (set_last_use[way] < set_last_use[way_to_evict]) {
+              way_to_evict = way;
+            }
+          }
+          break;
         }
-      } else {
-        throw ConfigurationError("Undefined RCC eviction policy.");
       }
 
-      return tag_to_evict;
+      return way_to_evict;
     };
 
     void reserve_rows_for_rct() {
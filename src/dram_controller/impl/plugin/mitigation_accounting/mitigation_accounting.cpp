@@ -0,0 +1,194 @@
+#include <algorithm>
+
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
+
+namespace Ramulator {
+
+void MitigationStats::register_stats(Implementation* plugin) {
+    plugin->register_stat(s_num_requests).name("mitigation_num_requests")
+                                         .desc("Number of requests issued by the mitigation");
+    plugin->register_stat(s_num_commands).name("mitigation_num_commands")
+                                         .desc("Number of DRAM commands issued by the mitigation");
+    plugin->register_stat(s_num_data_commands).name("mitigation_num_data_commands")
+                                              .desc("Number of RD/WR commands issued by the mitigation");
+    plugin->register_stat(s_num_demand_data_commands).name("mitigation_num_demand_data_commands")
+                                                     .desc("Number of RD/WR commands issued for demand requests").computed_at_finalize();
+    plugin->register_stat(s_bandwidth_overhead).name("mitigation_bandwidth_overhead")
+                                               .desc("Data commands of the mitigation per demand data command").computed_at_finalize();
+    plugin->register_stat(s_bank_blocked_cycles).name("mitigation_bank_blocked_cycles")
+                                                .desc("Cycles the banks are blocked by the mitigation, summed over all banks");
+    plugin->register_stat(s_max_bank_blocked_cycles).name("mitigation_max_bank_blocked_cycles")
+                                                    .desc("Cycles the most blocked bank is blocked by the mitigation").computed_at_finalize();
+    plugin->register_stat(s_demand_read_delay).name("mitigation_demand_read_delay")
+                                              .desc("Cycles demand reads are delayed by the mitigation, summed over all reads");
+    plugin->register_stat(s_avg_demand_read_delay).name("mitigation_avg_demand_read_delay")
+                                                  .desc("Average delay of a demand read caused by the mitigation").computed_at_finalize();
+}
+
+void MitigationAccounting::init(IDRAM* dram, const std::vector<IControllerPlugin*>& plugins, const std::vector<ReqBuffer*>& demand_buffers) {
+    m_dram = dram;
+    m_demand_buffers = demand_buffers;
+
+    for (auto plugin : plugins) {
+        MitigationStats* stats = plugin->get_mitigation_stats();
+        if (stats) {
+            stats->m_id = m_mitigations.size();
+            m_is_enabled = true;
+        }
+        m_mitigations.push_back(stats);
+    }
+    if (!m_is_enabled) {
+        return;
+    }
+
+    m_rank_level = m_dram->m_levels("rank");
+    m_bank_level = m_dram->m_levels("bank");
+
+    // Enumerate the banks of the channel in the order of their flat ids
+    m_num_banks = 1;
+    for (int level = m_rank_level; level <= m_bank_level; level++) {
+        m_num_banks *= m_dram->m_organization.count[level];
+    }
+    m_bank_addrs.assign(m_num_banks, AddrVec_t(m_bank_level + 1, 0));
+    for (int flat_bank_id = 0; flat_bank_id < m_num_banks; flat_bank_id++) {
+        int remainder = flat_bank_id;
+        for (int level = m_bank_level; level >= m_rank_level; level--) {
+            int level_size = m_dram->m_organization.count[level];
+            m_bank_addrs[flat_bank_id][level] = remainder % level_size;
+            remainder /= level_size;
+        }
+    }
+
+    // A command blocks its banks until the longest timing constraint it imposes on the next command is met.
+    // Entering power-down or self-refresh is not an access, so its (longer) entry delays do not count.
+    int num_commands = m_dram->m_commands.size();
+    std::vector<bool> is_low_power_entry(num_commands, false);
+    for (auto cmd_name : {"PDE", "SRE"}) {
+        if (m_dram->m_commands.contains(cmd_name)) {
+            is_low_power_entry[m_dram->m_commands(cmd_name)] = true;
+        }
+    }
+    m_block_cycles.assign(num_commands, 0);
+    for (int level = 0; level < (int) m_dram->m_timing_cons.size(); level++) {
+        for (int cmd = 0; cmd < num_commands; cmd++) {
+            for (const auto& cons : m_dram->m_timing_cons[level][cmd]) {
+                if (!cons.sibling && cons.window == 1 && !is_low_power_entry[cons.cmd]) {
+                    m_block_cycles[cmd] = std::max<Clk_t>(m_block_cycles[cmd], cons.val);
+                }
+            }
+        }
+    }
+
+    m_blocked_until.assign(m_mitigations.size() * m_num_banks, 0);
+    m_blocked_cycles.assign(m_mitigations.size() * m_num_banks, 0);
+    m_new_blocked_cycles.assign(m_num_banks, 0);
+    m_newly_blocked_banks.reserve(m_num_banks);
+}
+
+void MitigationAccounting::account_mitigation(Clk_t clk, const Request& req) {
+    MitigationStats* stats = m_mitigations[req.mitigation_id];
+    const DRAMCommandMeta& meta = m_dram->m_command_meta(req.command);
+
+    stats->s_num_commands++;
+    if (meta.is_accessing) {
+        stats->s_num_data_commands++;
+    }
+    if (req.command == req.final_command) {
+        stats->s_num_requests++;
+    }
+
+    Clk_t block_end = clk + m_block_cycles[req.command];
+    int scope = m_dram->m_command_scopes(req.command);
+    bool is_single_bank = scope >= m_bank_level;
+    for (int level = m_rank_level; is_single_bank && level <= m_bank_level; level++) {
+        is_single_bank = req.addr_vec[level] != -1;
+    }
+    if (is_single_bank) {
+        block_bank(req.mitigation_id, get_flat_bank_id(req.addr_vec), clk, block_end);
+    } else {
+        for (int flat_bank_id = 0; flat_bank_id < m_num_banks; flat_bank_id++) {
+            if (is_in_scope(req.addr_vec, scope, flat_bank_id)) {
+                block_bank(req.mitigation_id, flat_bank_id, clk, block_end);
+            }
+        }
+    }
+    if (m_newly_blocked_banks.empty()) {
+        return;
+    }
+
+    for (int flat_bank_id : m_newly_blocked_banks) {
+        stats->s_bank_blocked_cycles += m_new_blocked_cycles[flat_bank_id];
+    }
+
+    // Every demand read waiting for a bank now waits for the cycles newly blocked in it
+    for (auto buffer : m_demand_buffers) {
+        for (const auto& demand_req : *buffer) {
+            if (demand_req.type_id == Request::Type::Read && demand_req.mitigation_id == -1) {
+                stats->s_demand_read_delay += m_new_blocked_cycles[get_flat_bank_id(demand_req.addr_vec)];
+            }
+        }
+    }
+
+    for (int flat_bank_id : m_newly_blocked_banks) {
+        m_new_blocked_cycles[flat_bank_id] = 0;
+    }
+    m_newly_blocked_banks.clear();
+}
+
+void MitigationAccounting::block_bank(int mitigation_id, int flat_bank_id, Clk_t clk, Clk_t block_end) {
+    Clk_t& blocked_until = m_blocked_until[mitigation_id * m_num_banks + flat_bank_id];
+    Clk_t block_start = std::max(clk, blocked_until);
+    if (block_end <= block_start) {
+        return;
+    }
+    uint64_t new_cycles = block_end - block_start;
+    blocked_until = block_end;
+    m_blocked_cycles[mitigation_id * m_num_banks + flat_bank_id] += new_cycles;
+    m_new_blocked_cycles[flat_bank_id] = new_cycles;
+    m_newly_blocked_banks.push_back(flat_bank_id);
+}
+
+void MitigationAccounting::account_demand(const Request& req) {
+    if (m_dram->m_command_meta(req.command).is_accessing) {
+        m_num_demand_data_commands++;
+    }
+    if (req.type_id == Request::Type::Read && req.command == req.final_command) {
+        m_num_demand_reads++;
+    }
+}
+
+void MitigationAccounting::finalize() {
+    for (int id = 0; id < (int) m_mitigations.size(); id++) {
+        MitigationStats* stats = m_mitigations[id];
+        if (!stats) {
+            continue;
+        }
+        stats->s_num_demand_data_commands = m_num_demand_data_commands;
+        stats->s_bandwidth_overhead = m_num_demand_data_commands == 0 ? 0 : (float) stats->s_num_data_commands / (float) m_num_demand_data_commands;
+        for (int flat_bank_id = 0; flat_bank_id < m_num_banks; flat_bank_id++) {
+            stats->s_max_bank_blocked_cycles = std::max(stats->s_max_bank_blocked_cycles, m_blocked_cycles[id * m_num_banks + flat_bank_id]);
+        }
+        stats->s_avg_demand_read_delay = m_num_demand_reads == 0 ? 0 : (float) stats->s_demand_read_delay / (float) m_num_demand_reads;
+    }
+}
+
+int MitigationAccounting::get_flat_bank_id(const AddrVec_t& addr_vec) const {
+    int flat_bank_id = 0;
+    for (int level = m_rank_level; level <= m_bank_level; level++) {
+        flat_bank_id = flat_bank_id * m_dram->m_organization.count[level] + addr_vec[level];
+    }
+    return flat_bank_id;
+}
+
+bool MitigationAccounting::is_in_scope(const AddrVec_t& addr_vec, int scope, int flat_bank_id) const {
+    // Levels below the scope of the command, and wildcards (-1), cover all banks under them
+    int last_level = std::min(scope, m_bank_level);
+    for (int level = m_rank_level; level <= last_level; level++) {
+        if (addr_vec[level] != -1 && addr_vec[level] != m_bank_addrs[flat_bank_id][level]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}   // namespace Ramulator
@@ -0,0 +1,108 @@
+#ifndef RAMULATOR_PLUGUTIL_MITIGATIONACCOUNTING_H
+#define RAMULATOR_PLUGUTIL_MITIGATIONACCOUNTING_H
+
+#include <vector>
+#include <cstdint>
+
+#include "base/base.h"
+#include "dram/dram.h"
+#include "dram_controller/plugin.h"
+
+namespace Ramulator {
+
+/**
+ * @brief   The performance cost of a RowHammer mitigation, reported with the same schema by every mitigation.
+ * @details
+ * A mitigation owns one, registers its stats in init(), points m_mitigation_stats to it, and tags the requests it
+ * issues (e.g., VRRs, RFMs, swaps) with tag(). The tagged commands are then accounted by MitigationAccounting.
+ * Mitigations that delay demand requests without issuing commands (e.g., throttling) call add_demand_read_delay().
+ */
+class MitigationStats {
+    friend class MitigationAccounting;
+
+public:
+    void register_stats(Implementation* plugin);
+
+    /**
+     * @brief   Marks req as issued by this mitigation. Call before sending it to the controller.
+     */
+    void tag(Request& req) const { req.mitigation_id = m_id; };
+
+    int get_id() const { return m_id; };
+
+    void add_demand_read_delay(uint64_t cycles) { s_demand_read_delay += cycles; };
+
+private:
+    int m_id = -1;    // Assigned by the MitigationAccounting of the controller
+
+    uint64_t s_num_requests = 0;
+    uint64_t s_num_commands = 0;
+    uint64_t s_num_data_commands = 0;
+    uint64_t s_num_demand_data_commands = 0;
+    float s_bandwidth_overhead = 0;         // Data commands of the mitigation per demand data command
+    uint64_t s_bank_blocked_cycles = 0;     // Summed over all banks
+    uint64_t s_max_bank_blocked_cycles = 0;
+    uint64_t s_demand_read_delay = 0;       // Summed over all demand reads
+    float s_avg_demand_read_delay = 0;
+};
+
+/**
+ * @brief   Attributes the commands issued by the RowHammer mitigations of a controller to them.
+ * @details
+ * A mitigation command blocks the banks in its scope for the longest (non-sibling, non-window) timing constraint
+ * that follows it. The blocked intervals of a mitigation are merged per bank, so the commands of, e.g., a swap
+ * are not counted twice. Every demand read waiting for a bank when it gets blocked is delayed by the newly
+ * blocked cycles. Both are estimates of the performance cost, but they need no baseline run to compare against.
+ */
+class MitigationAccounting {
+public:
+    void init(IDRAM* dram, const std::vector<IControllerPlugin*>& plugins, const std::vector<ReqBuffer*>& demand_buffers);
+
+    /**
+     * @brief   Accounts the command issued in this cycle, if any (call before issuing it).
+     */
+    void update(Clk_t clk, bool request_found, ReqBuffer::iterator& req_it) {
+        if (!m_is_enabled || !request_found) {
+            return;
+        }
+        if (req_it->mitigation_id != -1) {
+            account_mitigation(clk, *req_it);
+        } else if (req_it->type_id == Request::Type::Read || req_it->type_id == Request::Type::Write) {
+            account_demand(*req_it);
+        }
+    };
+
+    void finalize();
+
+private:
+    IDRAM* m_dram = nullptr;
+    bool m_is_enabled = false;
+    std::vector<MitigationStats*> m_mitigations;   // [plugin id], nullptr if the plugin is not a mitigation
+    std::vector<ReqBuffer*> m_demand_buffers;
+
+    int m_rank_level = -1;
+    int m_bank_level = -1;
+    int m_num_banks = 0;
+    std::vector<AddrVec_t> m_bank_addrs;           // [flat bank id], the address of the bank down to the bank level
+    std::vector<Clk_t> m_block_cycles;             // [command]
+
+    uint64_t m_num_demand_data_commands = 0;
+    uint64_t m_num_demand_reads = 0;
+
+    std::vector<Clk_t> m_blocked_until;            // [plugin id][flat bank id]
+    std::vector<uint64_t> m_blocked_cycles;        // [plugin id][flat bank id]
+
+    std::vector<uint64_t> m_new_blocked_cycles;    // [flat bank id], blocked by the command being accounted
+    std::vector<int> m_newly_blocked_banks;        // The banks with nonzero m_new_blocked_cycles
+
+    void account_mitigation(Clk_t clk, const Request& req);
+    void block_bank(int mitigation_id, int flat_bank_id, Clk_t clk, Clk_t block_end);
+    void account_demand(const Request& req);
+
+    int get_flat_bank_id(const AddrVec_t& addr_vec) const;
+    bool is_in_scope(const AddrVec_t& addr_vec, int scope, int flat_bank_id) const;
+};
+
+}       // namespace Ramulator
+
+#endif  // RAMULATOR_PLUGUTIL_MITIGATIONACCOUNTING_H
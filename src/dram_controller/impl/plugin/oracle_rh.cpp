@@ -1,12 +1,13 @@
 #include <vector>
 #include <deque>
-#include <unordered_map>
 #include <limits>
 #include <random>
 
 #include "base/base.h"
 #include "dram_controller/controller.h"
 #include "dram_controller/plugin.h"
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
+#include "dram_controller/impl/plugin/row_counter_table/row_counter_table.h"
 
 namespace Ramulator {
 
@@ -16,10 +17,11 @@ class OracleRH : public IControllerPlugin, public Implementation {
   private:
     IDRAM* m_dram = nullptr;
 
-    using BankACTCounter = std::unordered_map<Addr_t, int>;
-    std::vector<BankACTCounter> m_table;
+    // Per-bank ACT counters, indexed using the flattened <rank id, bank id>
+    RowCounterTable<int> m_table;
 
     int m_RH_threshold = -1;
+    int m_table_capacity = -1;
 
     int m_VRR_req_id = -1;
 
@@ -33,10 +35,21 @@ class OracleRH : public IControllerPlugin, public Implementation {
 
     bool m_is_debug = false;
 
+    size_t s_num_table_overflows = 0;
+
+    MitigationStats m_mitigation;
+
   public:
     void init() override { 
       m_is_debug = param<bool>("debug").default_val(false);
       m_RH_threshold = param<int>("tRH").required();
+      m_table_capacity = param<int>("table_capacity").desc("Maximum number of rows tracked per bank").default_val(8192);
+
+      subscribe_commands(OpeningCommands | RefreshingCommands);
+
+      register_stat(s_num_table_overflows).name("oracle_rh_num_table_overflows").desc("Number of ACTs to untracked rows when the table is full");
+      m_mitigation.register_stats(this);
+      m_mitigation_stats = &m_mitigation;
     };
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
@@ -59,7 +72,7 @@ class OracleRH : public IControllerPlugin, public Implementation {
                              m_dram->get_level_size("bankgroup") * m_dram->get_level_size("bank");
       m_num_rows_per_bank = m_dram->get_level_size("row");
 
-      m_table.resize(m_num_banks_per_rank * m_num_ranks);
+      m_table.init(m_num_banks_per_rank * m_num_ranks, m_table_capacity);
     };
 
     void update(bool request_found, ReqBuffer::iterator& req_it) override {
@@ -76,22 +89,25 @@ class OracleRH : public IControllerPlugin, public Implementation {
           }
           
           int row_id = req_it->addr_vec[m_row_level];
-          if (m_table[flat_bank_id].find(row_id) != m_table[flat_bank_id].end()) {
-            m_table[flat_bank_id][row_id]++;
-            if (m_table[flat_bank_id][row_id] >= m_RH_threshold) {
-              m_table[flat_bank_id][row_id] = 0;
+          int* act_count = m_table.find(flat_bank_id, row_id);
+          if (act_count) {
+            (*act_count)++;
+            if (*act_count >= m_RH_threshold) {
+              *act_count = 0;
               Request vrr_req(req_it->addr_vec, m_VRR_req_id);
+              m_mitigation.tag(vrr_req);
               m_ctrl->priority_send(vrr_req);
             }
-          } else {
-            m_table[flat_bank_id][row_id] = 1;
+          } else if (!m_table.insert(flat_bank_id, row_id, 1)) {
+            s_num_table_overflows++;
           }
         } else if (
           m_dram->m_command_meta(req_it->command).is_refreshing && 
           m_dram->m_command_scopes(req_it->command) == m_rank_level) {
             int rank_id = req_it->addr_vec[m_rank_level];
             for (int i = rank_id * m_num_banks_per_rank; i < (rank_id + 1) * m_num_banks_per_rank; i++) {
-              m_table[i].clear();
+              // O(1): bumps the epoch of the table
+              m_table.clear(i);
             }
         }
       }
@@ -1,11 +1,12 @@
 #include <vector>
 #include <unordered_map>
 #include <limits>
-#include <random>
+#include <array>
 
 #include "base/base.h"
 #include "dram_controller/controller.h"
 #include "dram_controller/plugin.h"
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
 
 namespace Ramulator {
 
@@ -17,26 +18,33 @@ class PARA : public IControllerPlugin, public Implementation {
 
     float m_pr_threshold;
 
-    int   m_seed;
-    std::mt19937 m_generator;
-    std::uniform_real_distribution<float> m_distribution;
+    // Bernoulli(threshold) draws are generated in batches of m_draws.size()
+    int m_seed = 0;
+    RandomStream m_rng;
+    std::array<bool, 256> m_draws;
+    size_t m_draw_idx = 0;
     bool m_is_debug = false;
 
     int m_VRR_req_id = -1;
     int m_bank_level = -1;
     int m_row_level = -1;
 
+    MitigationStats m_mitigation;
+
   public:
     void init() override { 
       m_pr_threshold = param<float>("threshold").desc("Probability threshold for issuing neighbor row refresh").required();
       if (m_pr_threshold <= 0.0f || m_pr_threshold >= 1.0f)
         throw ConfigurationError("Invalid probability threshold ({}) for PARA!", m_pr_threshold);
 
-      m_seed = param<int>("seed").desc("Seed for the RNG").default_val(123);
-      m_generator = std::mt19937(m_seed);
-      m_distribution = std::uniform_real_distribution<float>(0.0, 1.0);
+      m_seed = param<int>("seed").desc("Offset of the RNG stream of PARA, on top of the top-level seed").default_val(0);
 
       m_is_debug = param<bool>("debug").default_val(false);
+
+      subscribe_commands(OpeningCommands);
+
+      m_mitigation.register_stats(this);
+      m_mitigation_stats = &m_mitigation;
     };
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
@@ -50,6 +58,10 @@ class PARA : public IControllerPlugin, public Implementation {
       m_VRR_req_id = m_dram->m_requests("victim-row-refresh");
       m_bank_level = m_dram->m_levels("bank");
       m_row_level = m_dram->m_levels("row");
+
+      // The stream is derived from the path of the plugin, which includes the channel id of the controller
+      m_rng = create_rng_stream("", m_seed);
+      m_draw_idx = m_draws.size();
     };
 
     void update(bool request_found, ReqBuffer::iterator& req_it) override {
@@ -58,8 +70,13 @@ class PARA : public IControllerPlugin, public Implementation {
           m_dram->m_command_meta(req_it->command).is_opening && 
           m_dram->m_command_scopes(req_it->command) == m_row_level
         ) {
-          if (m_distribution(m_generator) < m_pr_threshold) {
+          if (m_draw_idx == m_draws.size()) {
+            m_rng.fill_bernoulli(m_draws.data(), m_draws.size(), m_pr_threshold);
+            m_draw_idx = 0;
+          }
+          if (m_draws[m_draw_idx++]) {
             Request vrr_req(req_it->addr_vec, m_VRR_req_id);
+            m_mitigation.tag(vrr_req);
             m_ctrl->priority_send(vrr_req);
           }
         }
@@ -0,0 +1,66 @@
+#include "dram_controller/impl/plugin/plugin_dispatcher/plugin_dispatcher.h"
+
+namespace Ramulator {
+
+void PluginDispatcher::init(IDRAM* dram, const std::vector<IControllerPlugin*>& plugins) {
+    m_dram = dram;
+    m_plugins = plugins;
+}
+
+void PluginDispatcher::update(Clk_t clk, bool request_found, ReqBuffer::iterator& req_it) {
+    if (!m_is_built) {
+        build(clk);
+    }
+
+    while (!m_timer_queue.empty() && m_timer_queue.top().clk <= clk) {
+        TimerEvent event = m_timer_queue.top();
+        m_timer_queue.pop();
+        m_timers[event.timer_id]->callback();
+        m_timer_queue.push({event.clk + m_timers[event.timer_id]->period, event.timer_id});
+    }
+
+    const auto& plugins = request_found ? m_command_plugins[req_it->command] : m_every_cycle_plugins;
+    for (auto plugin : plugins) {
+        plugin->update(request_found, req_it);
+    }
+}
+
+void PluginDispatcher::build(Clk_t clk) {
+    int num_commands = m_dram->m_commands.size();
+    m_command_plugins.resize(num_commands);
+
+    for (auto plugin : m_plugins) {
+        if (!plugin->m_is_subscribed) {
+            m_every_cycle_plugins.push_back(plugin);
+        }
+
+        for (int cmd_id = 0; cmd_id < num_commands; cmd_id++) {
+            const DRAMCommandMeta& meta = m_dram->m_command_meta(cmd_id);
+            uint32_t command_classes = plugin->m_command_classes;
+            bool is_interested = !plugin->m_is_subscribed ||
+                                 command_classes == IControllerPlugin::AllCommands ||
+                                 (meta.is_opening    && (command_classes & IControllerPlugin::OpeningCommands)) ||
+                                 (meta.is_closing    && (command_classes & IControllerPlugin::ClosingCommands)) ||
+                                 (meta.is_accessing  && (command_classes & IControllerPlugin::AccessingCommands)) ||
+                                 (meta.is_refreshing && (command_classes & IControllerPlugin::RefreshingCommands));
+            if (is_interested) {
+                m_command_plugins[cmd_id].push_back(plugin);
+            }
+        }
+
+        for (auto& timer : plugin->m_timers) {
+            if (timer.period <= 0) {
+                throw ConfigurationError("Timer period of a controller plugin must be positive!");
+            }
+            // The timers are aligned to the controller clock, i.e., they fire when clk % period == offset
+            Clk_t offset = timer.offset % timer.period;
+            Clk_t first_clk = (clk - offset + timer.period - 1) / timer.period * timer.period + offset;
+            m_timer_queue.push({first_clk, (int) m_timers.size()});
+            m_timers.push_back(&timer);
+        }
+    }
+
+    m_is_built = true;
+}
+
+}   // namespace Ramulator
@@ -0,0 +1,53 @@
+#ifndef RAMULATOR_PLUGUTIL_PLUGINDISPATCHER_H
+#define RAMULATOR_PLUGUTIL_PLUGINDISPATCHER_H
+
+#include <vector>
+#include <queue>
+
+#include "base/base.h"
+#include "dram/dram.h"
+#include "dram_controller/plugin.h"
+
+namespace Ramulator {
+
+/**
+ * @brief   Calls the controller plugins on the cycles they subscribed to.
+ * @details
+ * A plugin that did not subscribe to anything is updated every cycle. The per-command plugin lists keep the
+ * order of the plugins in the configuration, and are built on the first cycle, when all plugins are set up.
+ */
+class PluginDispatcher {
+public:
+    void init(IDRAM* dram, const std::vector<IControllerPlugin*>& plugins);
+
+    /**
+     * @brief   Fires the due timers, then updates the plugins interested in this cycle.
+     */
+    void update(Clk_t clk, bool request_found, ReqBuffer::iterator& req_it);
+
+private:
+    struct TimerEvent {
+        Clk_t clk;
+        int timer_id;
+
+        bool operator>(const TimerEvent& other) const {
+            return clk > other.clk || (clk == other.clk && timer_id > other.timer_id);
+        }
+    };
+
+    IDRAM* m_dram = nullptr;
+    std::vector<IControllerPlugin*> m_plugins;
+    bool m_is_built = false;
+
+    std::vector<IControllerPlugin*> m_every_cycle_plugins;
+    std::vector<std::vector<IControllerPlugin*>> m_command_plugins;   // [command id], includes the every-cycle plugins
+
+    std::vector<IControllerPlugin::Timer*> m_timers;
+    std::priority_queue<TimerEvent, std::vector<TimerEvent>, std::greater<TimerEvent>> m_timer_queue;
+
+    void build(Clk_t clk);
+};
+
+}       // namespace Ramulator
+
+#endif  // RAMULATOR_PLUGUTIL_PLUGINDISPATCHER_H
@@ -1,6 +1,7 @@
 #include "base/base.h"
 #include "dram_controller/controller.h"
 #include "dram_controller/plugin.h"
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
 
 namespace Ramulator {
 
@@ -11,7 +12,6 @@ private:
     IDRAM* m_dram = nullptr;
     std::vector<int> m_bank_ctrs;
 
-    Clk_t m_clk = 0;
 
     int m_rfm_req_id = -1;
     int m_no_send = -1;
@@ -34,10 +34,17 @@ private:
 
     int s_rfm_counter = 0;
 
+    MitigationStats m_mitigation;
+
 public:
     void init() override { 
         m_rfm_thresh = param<int>("rfm_thresh").default_val(80);
         m_debug = param<bool>("debug").default_val(false);
+
+        subscribe_commands(OpeningCommands);
+
+        m_mitigation.register_stats(this);
+        m_mitigation_stats = &m_mitigation;
     }
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
@@ -74,8 +81,6 @@ public:
     }
 
     void update(bool request_found, ReqBuffer::iterator& req_it) override {
-        m_clk++;
-
         if (!request_found) {
             return;
         }
@@ -115,6 +120,7 @@ public:
         rfm.addr_vec[m_bankgroup_level] = -1;
         rfm.addr_vec[m_bank_level] = -1;
         // TODO: Add a buffer to retry later
+        m_mitigation.tag(rfm);
         if (!m_ctrl->priority_send(rfm)) {
             std::cout << "[Ramulator::RFMManager] [CRITICAL ERROR] Could not send request: rfm" << std::endl; 
             exit(0);
@@ -0,0 +1,116 @@
+#ifndef RAMULATOR_PLUGUTIL_ROWCOUNTERTABLE_H
+#define RAMULATOR_PLUGUTIL_ROWCOUNTERTABLE_H
+
+#include <vector>
+#include <cstdint>
+
+#include "base/base.h"
+#include "dram_controller/impl/plugin/hash_index/hash_index.h"
+
+namespace Ramulator {
+
+/**
+ * @brief   A set of capacity-bounded row -> Value_t tables, e.g., one per bank.
+ * @details
+ * The entries of a table are kept dense in insertion order (up to erasures, which move the last entry into the hole),
+ * so erase_if() sweeps only the live entries. A HashIndex maps rows to their entries. insert() fails instead of
+ * growing once a table holds capacity rows, which keeps the memory footprint fixed after init().
+ */
+template <typename Value_t>
+class RowCounterTable {
+public:
+    void init(int num_tables, int capacity) {
+        m_capacity = capacity;
+        m_sizes.assign(num_tables, 0);
+        m_entries.assign((size_t) num_tables * capacity, Entry());
+        m_index.init(num_tables, capacity);
+    };
+
+    /**
+     * @brief   Removes all entries of the table.
+     */
+    void clear(int table_id) {
+        m_sizes[table_id] = 0;
+        m_index.clear(table_id);
+    };
+
+    /**
+     * @brief   Returns the value of row, or nullptr if it is not in the table.
+     */
+    Value_t* find(int table_id, int row) {
+        int e = m_index.find(table_id, row);
+        if (e == -1) {
+            return nullptr;
+        }
+        return &get_entries(table_id)[e].value;
+    };
+
+    /**
+     * @brief   Inserts row (which must not be in the table). Returns its value, or nullptr if the table is full.
+     */
+    Value_t* insert(int table_id, int row, const Value_t& value) {
+        if (m_sizes[table_id] == m_capacity) {
+            return nullptr;
+        }
+        int e = m_sizes[table_id]++;
+        get_entries(table_id)[e] = {row, value};
+        m_index.insert(table_id, row, e);
+        return &get_entries(table_id)[e].value;
+    };
+
+    void erase(int table_id, int row) {
+        int e = m_index.find(table_id, row);
+        if (e != -1) {
+            erase_entry(table_id, e);
+        }
+    };
+
+    /**
+     * @brief   Calls func(row, value) for every entry of the table and erases the entries it returns true for.
+     */
+    template <typename Func_t>
+    void erase_if(int table_id, Func_t&& func) {
+        Entry* entries = get_entries(table_id);
+        for (int e = 0; e < m_sizes[table_id]; ) {
+            if (func(entries[e].key, entries[e].value)) {
+                // The last entry is moved into e, so e is visited again
+                erase_entry(table_id, e);
+            } else {
+                e++;
+            }
+        }
+    };
+
+    int get_size(int table_id) const { return m_sizes[table_id]; };
+    int get_capacity() const { return m_capacity; };
+
+private:
+    struct Entry {
+        int key = -1;
+        Value_t value {};
+    };
+
+    int m_capacity = 0;
+
+    std::vector<int> m_sizes;        // [table]
+    std::vector<Entry> m_entries;    // [table][entry], the first size entries of a table are valid
+    HashIndex m_index;
+
+    Entry* get_entries(int table_id) { return &m_entries[(size_t) table_id * m_capacity]; };
+
+    void erase_entry(int table_id, int e) {
+        Entry* entries = get_entries(table_id);
+        m_index.erase(table_id, entries[e].key);
+
+        // Keep the entries dense by moving the last entry into the hole
+        int last = --m_sizes[table_id];
+        if (e != last) {
+            entries[e] = entries[last];
+            m_index.update(table_id, entries[e].key, e);
+        }
+    };
+};
+
+}       // namespace Ramulator
+
+#endif  // RAMULATOR_PLUGUTIL_ROWCOUNTERTABLE_H
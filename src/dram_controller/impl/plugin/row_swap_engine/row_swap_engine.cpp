@@ -0,0 +1,112 @@
+#include <algorithm>
+
+#include "dram_controller/impl/plugin/row_swap_engine/row_swap_engine.h"
+
+namespace Ramulator {
+
+void RowSwapEngine::init(Implementation* plugin, IDRAMController* ctrl, const MitigationStats& mitigation) {
+    m_ctrl = ctrl;
+    m_mitigation = &mitigation;
+
+    m_max_concurrent_swaps = plugin->param<int>("swap_max_concurrent").desc("Number of swaps/migrations that make progress at the same time").default_val(1);
+    m_max_inflight_requests = plugin->param<int>("swap_max_inflight_requests").desc("Number of swap/migration requests that can wait in the controller (default: one row)").default_val(-1);
+
+    IDRAM* dram = m_ctrl->m_dram;
+    m_RD_req_id = dram->m_requests("read");
+    m_WR_req_id = dram->m_requests("write");
+    m_row_level = dram->m_levels("row");
+    m_col_level = dram->m_levels("column");
+    m_cl_stride = dram->m_internal_prefetch_size;
+    m_num_cls = dram->m_organization.count[m_col_level] / m_cl_stride;
+
+    if (m_max_inflight_requests == -1) {
+        m_max_inflight_requests = m_num_cls;
+    }
+    if (m_max_concurrent_swaps <= 0 || m_max_inflight_requests <= 0) {
+        throw ConfigurationError("[{}] swap_max_concurrent and swap_max_inflight_requests must be positive!", plugin->get_name());
+    }
+
+    plugin->register_stat(s_num_swaps).name("swap_engine_num_swaps");
+    plugin->register_stat(s_num_migrations).name("swap_engine_num_migrations");
+    plugin->register_stat(s_num_requests).name("swap_engine_num_requests")
+                                         .desc("Number of RD/WR requests sent for the swaps and migrations");
+    plugin->register_stat(s_max_queued_jobs).name("swap_engine_max_queued_jobs")
+                                            .desc("Maximum number of swaps and migrations waiting or in progress");
+    plugin->register_stat(s_avg_job_cycles).name("swap_engine_avg_job_cycles")
+                                           .desc("Average cycles from enqueuing a swap/migration until its last request is sent");
+}
+
+void RowSwapEngine::enqueue_swap(const AddrVec_t& addr_vec, int row_a, int row_b) {
+    // Read both rows into the swap buffers, then write them back exchanged
+    Job job;
+    job.steps[0] = {row_a, m_RD_req_id};
+    job.steps[1] = {row_b, m_RD_req_id};
+    job.steps[2] = {row_b, m_WR_req_id};
+    job.steps[3] = {row_a, m_WR_req_id};
+    job.num_steps = 4;
+    job.addr_vec = addr_vec;
+    s_num_swaps++;
+    enqueue(job);
+}
+
+void RowSwapEngine::enqueue_migration(const AddrVec_t& addr_vec, int src_row, int dst_row) {
+    // Read the source row into the copy buffer, then write it to the destination row
+    Job job;
+    job.steps[0] = {src_row, m_RD_req_id};
+    job.steps[1] = {dst_row, m_WR_req_id};
+    job.num_steps = 2;
+    job.addr_vec = addr_vec;
+    s_num_migrations++;
+    enqueue(job);
+}
+
+void RowSwapEngine::enqueue(Job& job) {
+    job.enqueue_clk = m_ctrl->get_clk();
+    m_jobs.push_back(std::move(job));
+    s_max_queued_jobs = std::max<uint64_t>(s_max_queued_jobs, m_jobs.size());
+    send_requests();
+}
+
+void RowSwapEngine::update(bool request_found, ReqBuffer::iterator& req_it) {
+    if (request_found && is_engine_request(*req_it) && req_it->command == req_it->final_command) {
+        m_num_inflight--;
+    }
+    send_requests();
+}
+
+void RowSwapEngine::send_requests() {
+    while (!m_jobs.empty() && m_num_inflight < m_max_inflight_requests) {
+        size_t num_active = std::min<size_t>(m_jobs.size(), m_max_concurrent_swaps);
+        if (m_next_job >= num_active) {
+            m_next_job = 0;
+        }
+        Job& job = m_jobs[m_next_job];
+
+        AddrVec_t addr_vec = job.addr_vec;
+        addr_vec[m_row_level] = job.steps[job.step].row;
+        addr_vec[m_col_level] = job.cl * m_cl_stride;
+        Request req(addr_vec, job.steps[job.step].type_id);
+        m_mitigation->tag(req);
+        if (!m_ctrl->priority_send(req)) {
+            // Retry when the priority buffer drains
+            return;
+        }
+        m_num_inflight++;
+        s_num_requests++;
+
+        if (++job.cl == m_num_cls) {
+            job.cl = 0;
+            job.step++;
+        }
+        if (job.step == job.num_steps) {
+            s_num_finished_jobs++;
+            s_job_cycles += m_ctrl->get_clk() - job.enqueue_clk;
+            s_avg_job_cycles = (float) s_job_cycles / (float) s_num_finished_jobs;
+            m_jobs.erase(m_jobs.begin() + m_next_job);
+        } else {
+            m_next_job++;
+        }
+    }
+}
+
+}   // namespace Ramulator
@@ -0,0 +1,88 @@
+#ifndef RAMULATOR_PLUGUTIL_ROWSWAPENGINE_H
+#define RAMULATOR_PLUGUTIL_ROWSWAPENGINE_H
+
+#include <deque>
+#include <cstdint>
+
+#include "base/base.h"
+#include "dram/dram.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
+
+namespace Ramulator {
+
+/**
+ * @brief   Turns the row swaps and migrations of a mitigation into a stream of RD/WR requests in the priority buffer.
+ * @details
+ * A swap reads both rows into the swap buffers and writes them back exchanged; a migration copies one row into
+ * another. Both move every cache line of the rows. Up to max_concurrent_swaps jobs make progress at the same time
+ * (round robin, one request each), and at most max_inflight_requests of their requests wait in the controller, so the
+ * data movement competes with the demand traffic instead of flooding the priority buffer at once.
+ *
+ * The owner calls update() from its own update() and subscribes to the accessing commands, so that the engine sees
+ * its requests complete. Only the bandwidth of the data movement is modeled: the owner updates the row indirection
+ * when it enqueues the job.
+ */
+class RowSwapEngine {
+public:
+    /**
+     * @brief   Reads the parameters and registers the stats of the engine in plugin (call in setup()).
+     */
+    void init(Implementation* plugin, IDRAMController* ctrl, const MitigationStats& mitigation);
+
+    void enqueue_swap(const AddrVec_t& addr_vec, int row_a, int row_b);
+    void enqueue_migration(const AddrVec_t& addr_vec, int src_row, int dst_row);
+
+    void update(bool request_found, ReqBuffer::iterator& req_it);
+
+    bool is_engine_request(const Request& req) const {
+        return req.mitigation_id != -1 && req.mitigation_id == m_mitigation->get_id();
+    };
+
+private:
+    struct Step {
+        int row;
+        int type_id;
+    };
+
+    struct Job {
+        AddrVec_t addr_vec;     // The bank of both rows
+        Step steps[4];
+        int num_steps = 0;
+        int step = 0;           // The next request is the cl-th cache line of steps[step]
+        int cl = 0;
+        Clk_t enqueue_clk = 0;
+    };
+
+    IDRAMController* m_ctrl = nullptr;
+    const MitigationStats* m_mitigation = nullptr;
+
+    int m_max_concurrent_swaps = -1;
+    int m_max_inflight_requests = -1;
+
+    int m_RD_req_id = -1;
+    int m_WR_req_id = -1;
+    int m_row_level = -1;
+    int m_col_level = -1;
+    int m_num_cls = -1;
+    int m_cl_stride = -1;
+
+    std::deque<Job> m_jobs;         // The first m_max_concurrent_swaps jobs are in progress
+    size_t m_next_job = 0;          // Round-robin pointer into the jobs in progress
+    int m_num_inflight = 0;
+
+    uint64_t s_num_swaps = 0;
+    uint64_t s_num_migrations = 0;
+    uint64_t s_num_requests = 0;
+    uint64_t s_max_queued_jobs = 0;
+    uint64_t s_num_finished_jobs = 0;
+    uint64_t s_job_cycles = 0;
+    float s_avg_job_cycles = 0;     // From enqueuing a job until its last request is sent
+
+    void enqueue(Job& job);
+    void send_requests();
+};
+
+}       // namespace Ramulator
+
+#endif  // RAMULATOR_PLUGUTIL_ROWSWAPENGINE_H
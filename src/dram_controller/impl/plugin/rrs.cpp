@@ -1,12 +1,13 @@
 #include <vector>
-#include <unordered_map>
 #include <limits>
-#include <random>
 
 #include "base/base.h"
 #include "dram_controller/controller.h"
 #include "dram_controller/plugin.h"
 #include "addr_mapper/impl/rit.h"
+#include "dram_controller/impl/plugin/frequent_item_tracker/frequent_item_tracker.h"
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
+#include "dram_controller/impl/plugin/row_swap_engine/row_swap_engine.h"
 
 namespace Ramulator {
 
@@ -17,8 +18,6 @@ class RRS : public IControllerPlugin, public Implementation {
     IDRAM* m_dram = nullptr;
     LinearMapperBase_with_rit* m_addr_mapper = nullptr;
 
-    int m_clk = 0;
-
     int m_num_hrt_entries = -1;
     int m_num_rit_entries = -1;
     int m_rss_threshold = -1;
@@ -26,9 +25,6 @@ class RRS : public IControllerPlugin, public Implementation {
     int m_reset_period_clk = -1;
     bool m_is_debug = false;
     
-    int m_RD_req_id = -1;
-    int m_WR_req_id = -1;
-
     int m_rank_level = -1;
     int m_bank_level = -1;
     int m_row_level = -1;
@@ -37,26 +33,25 @@ class RRS : public IControllerPlugin, public Implementation {
     int m_num_ranks = -1;
     int m_num_banks_per_rank = -1;
     int m_num_rows_per_bank = -1;
-    int m_num_cls = -1;
 
-    // per bank hot-row tracker (same as Graphene)
+    // per bank hot-row tracker with its spillover counter (same as Graphene)
     // indexed using flattened <rank id, bank id>
     // e.g., if rank 0, bank 4, index is 4
     // if rank 1, bank 5, index is 16 (assuming 16 banks/rank) + 5
-    std::vector<std::unordered_map<int, int>> m_hot_row_tracker;
-    // spillover counter per bank
-    std::vector<int> m_spillover_counter;
+    FrequentItemTracker m_hot_row_tracker;
     // per bank row indirection table is implemented in 'src/addr_mapper/impl/linear_mappers_with_rit.cpp'
     
     // rng
-    std::mt19937 generator;
-    std::uniform_int_distribution<int> distribution;
+    RandomStream m_rng;
 
     // statistics
     int s_num_swaps = 0;
     int s_num_unswaps = 0;
     int s_num_reswaps = 0;
 
+    MitigationStats m_mitigation;
+    RowSwapEngine m_swap_engine;
+
   public:
     void init() override { 
       m_num_hrt_entries = param<int>("num_hrt_entries").required();
@@ -64,6 +59,12 @@ class RRS : public IControllerPlugin, public Implementation {
       m_rss_threshold = param<int>("rss_threshold").required();
       m_reset_period_ns = param<int>("reset_period_ns").required();
       m_is_debug = param<bool>("debug").default_val(false);
+
+      // The swap engine needs to see its RD/WRs complete
+      subscribe_commands(OpeningCommands | AccessingCommands);
+
+      m_mitigation.register_stats(this);
+      m_mitigation_stats = &m_mitigation;
     };
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
@@ -72,9 +73,17 @@ class RRS : public IControllerPlugin, public Implementation {
       m_addr_mapper = (LinearMapperBase_with_rit*) memory_system->get_ifce<IAddrMapper>();
 
       m_reset_period_clk = m_reset_period_ns / ((float) m_dram->m_timing_vals("tCK_ps") / 1000.0f);
-
-      m_RD_req_id = m_dram->m_requests("read");
-      m_WR_req_id = m_dram->m_requests("write");
+      subscribe_timer(m_reset_period_clk, [this]() {
+        // Reset hrt and unlock rit
+        m_hot_row_tracker.reset();
+        m_addr_mapper->rit_unlock();
+        if (m_is_debug) {
+          std::cout << "----------------------------" << std::endl;
+          std::cout << "RRS is resetting. " << m_ctrl->get_clk() << std::endl;
+          for (int b = 0; b < m_num_banks_per_rank * m_num_ranks; b++)
+            m_addr_mapper->dump_rit(b);
+        }
+      });
 
       m_rank_level = m_dram->m_levels("rank");
       m_bank_level = m_dram->m_levels("bank");
@@ -86,21 +95,16 @@ class RRS : public IControllerPlugin, public Implementation {
                              m_dram->get_level_size("bank") : 
                              m_dram->get_level_size("bankgroup") * m_dram->get_level_size("bank");
       m_num_rows_per_bank = m_dram->get_level_size("row");
-      m_num_cls = m_dram->get_level_size("column") / 8;
 
-      // Initialize hot-row tracker
-      for (int i = 0; i < m_num_banks_per_rank * m_num_ranks; i++) {
-        std::unordered_map<int, int> table;
-        m_hot_row_tracker.push_back(table);
-      }
-      // Initialize spillover counter
-      m_spillover_counter = std::vector<int>(m_num_banks_per_rank * m_num_ranks, 0);
+      // Initialize hot-row tracker and spillover counters
+      m_hot_row_tracker.init(m_num_banks_per_rank * m_num_ranks, m_num_hrt_entries);
       // Initialize row indirection table in the addr_mapper
       m_addr_mapper->init_rit(m_num_banks_per_rank * m_num_ranks, m_num_rit_entries);
       
       // setup random number generator
-      generator = std::mt19937(1337);
-      distribution = std::uniform_int_distribution<int>(0, m_num_rows_per_bank);
+      m_rng = create_rng_stream();
+
+      m_swap_engine.init(this, m_ctrl, m_mitigation);
 
       // Register statistics
       register_stat(s_num_swaps).name("rss_num_swaps");
@@ -119,26 +123,13 @@ class RRS : public IControllerPlugin, public Implementation {
     };
 
     void update(bool request_found, ReqBuffer::iterator& req_it) override {
-      // Tick myself
-      m_clk++;
-
-      if (m_clk % m_reset_period_clk == 0) {
-        // Reset hrt and unlock rit
-        for (int i = 0; i < m_num_banks_per_rank * m_num_ranks; i++) {
-          m_hot_row_tracker[i].clear();
-          m_spillover_counter[i] = 0;
-          m_addr_mapper->rit_unlock();
-        }
-        if (m_is_debug) {
-          std::cout << "----------------------------" << std::endl;
-          std::cout << "RRS is resetting. " << m_clk << std::endl;
-          for (int b = 0; b < m_num_banks_per_rank * m_num_ranks; b++)
-            m_addr_mapper->dump_rit(b);
-        }
-      }
+      m_swap_engine.update(request_found, req_it);
 
       if (request_found) {
-        if (m_dram->m_command_meta(req_it->command).is_opening && m_dram->m_command_scopes(req_it->command) == m_row_level) {
+        // The copies of the swap engine re-open the rows they move whenever demand requests interleave with them,
+        // which a real swap buffer would not do, so they are not tracked
+        if (m_dram->m_command_meta(req_it->command).is_opening && m_dram->m_command_scopes(req_it->command) == m_row_level &&
+            !m_swap_engine.is_engine_request(*req_it)) {
           int flat_bank_id = req_it->addr_vec[m_bank_level];
           int accumulated_dimension = 1;
           for (int i = m_bank_level - 1; i >= m_rank_level; i--) {
@@ -150,78 +141,28 @@ class RRS : public IControllerPlugin, public Implementation {
 
           if (m_is_debug) {
             std::cout << "----------------------------" << std::endl;
-            std::cout << "RRS: ACT on row " << row_id << "         " << m_clk << std::endl;
+            std::cout << "RRS: ACT on row " << row_id << "         " << m_ctrl->get_clk() << std::endl;
             std::cout << "  └  " << "bank: " << flat_bank_id << std::endl;
           }
 
           // Check HRT
-          if (m_hot_row_tracker[flat_bank_id].find(row_id) == m_hot_row_tracker[flat_bank_id].end()) {
+          // if the row is not in the table and the table is full, it evicts a row with the spillover counter value,
+          // or, if there is no such row, the spillover counter is incremented
+          int count = m_hot_row_tracker.increment(flat_bank_id, row_id);
+          if (count == -1) {
             if (m_is_debug) {
-              std::cout << "  └  " << "row " << row_id << " not in HRT." << std::endl;
+              std::cout << "  └  " << "row " << row_id << " not in HRT and no row to evict, incrementing spillover counter." << std::endl;
             }
-            // if row is not in the table, check if the table is full 
-            if (m_hot_row_tracker[flat_bank_id].size() < m_num_hrt_entries) {
-              if (m_is_debug) {
-                std::cout << "  └  " << "HRT is not full, inserting with count 1." << std::endl;
-              }
-              // if table is not full, insert the row
-              m_hot_row_tracker[flat_bank_id][row_id] = 1;
-            } else {
-              if (m_is_debug) {
-                std::cout << "  └  " << "HRT is full, searching for a row to evict." << std::endl;
-              }
-              // if table is full, find a row to evict
-              bool found = false;
-              int to_remove = -1;
-              int spillover_value = -1;
-
-              for (auto it = m_hot_row_tracker[flat_bank_id].begin(); it != m_hot_row_tracker[flat_bank_id].end(); it++) {
-                // if we find an entry with spillover counter value, evict it
-                if (it->second == m_spillover_counter[flat_bank_id]) {
-                  if (m_is_debug) {
-                    std::cout << "  └  " << "found a row to evict: " << it->first << std::endl;
-                  }
-                  // if we find an entry, record it
-                  spillover_value = it->second;
-                  to_remove = it->first;
-                  found = true;
-                  break;
-                }
-              }
-
-              if (found) {
-                if (m_is_debug) {
-                  std::cout << "Removing row " << to_remove << " from HRT." << std::endl;
-                  std::cout << "Adding row " << row_id << " to HRT." << std::endl;
-                }
-                // remove to_remove from the table
-                m_hot_row_tracker[flat_bank_id].erase(to_remove);
-                // add row_id to the table
-                m_hot_row_tracker[flat_bank_id][row_id] = spillover_value + 1;
-              }
-              else {
-                if (m_is_debug) {
-                  std::cout << "  └  " << "no row to evict, incrementing spillover counter." << std::endl;
-                }
-                m_spillover_counter[flat_bank_id] += 1;
-                return;
-              }
-            }
-          } else {
-            if (m_is_debug) { 
-              std::cout << "  └  " << "row " << row_id << " in HRT. Incrementing its counter." << std::endl;
-            }
-            // if row in table, increment its activation count
-            m_hot_row_tracker[flat_bank_id][row_id] += 1;
+            return;
           }
           // dump HRT for debug
           if (m_is_debug) {
             std::cout << "==========================" << std::endl;
-            std::cout << "HRT[" << flat_bank_id << "].size(): " << m_hot_row_tracker[flat_bank_id].size() << std::endl;
-            for (auto entry: m_hot_row_tracker[flat_bank_id]) {
-              std::cout << entry.first << ":\t" << entry.second << std::endl; 
-            }
-            std::cout << "Spillover counter: " << m_spillover_counter[flat_bank_id] << std::endl;
+            std::cout << "HRT[" << flat_bank_id << "].size(): " << m_hot_row_tracker.get_size(flat_bank_id) << std::endl;
+            m_hot_row_tracker.for_each(flat_bank_id, [](int row, int row_count) {
+              std::cout << row << ":\t" << row_count << std::endl; 
+            });
+            std::cout << "Spillover counter: " << m_hot_row_tracker.get_spillover(flat_bank_id) << std::endl;
             std::cout << "==========================" << std::endl;
           }
 
@@ -229,9 +170,9 @@ class RRS : public IControllerPlugin, public Implementation {
           if (m_is_debug) {
             std::cout << "Row " << row_id << " in HRT" << std::endl;
             std::cout << "  └  " << "threshold: " << m_rss_threshold << std::endl;
-            std::cout << "  └  " << "count: " << m_hot_row_tracker[flat_bank_id][row_id] << std::endl;
+            std::cout << "  └  " << "count: " << count << std::endl;
           }
-          if (m_hot_row_tracker[flat_bank_id][row_id] % m_rss_threshold == 0) {
+          if (count % m_rss_threshold == 0) {
             if (m_is_debug) {
               std::cout << "Row " << row_id << " needs swapping!" << std::endl;
             }
@@ -249,7 +190,7 @@ class RRS : public IControllerPlugin, public Implementation {
                 // check if rit has empty slots
                 if (m_addr_mapper->is_rit_full(flat_bank_id)) {
                   // if rit is full, get a pair to unswap
-                  auto unswap_pair = m_addr_mapper->get_unswap_pair(flat_bank_id, m_hot_row_tracker[flat_bank_id]);
+                  auto unswap_pair = m_addr_mapper->get_unswap_pair(flat_bank_id, [&](int row) { return m_hot_row_tracker.contains(flat_bank_id, row); });
                   if (m_is_debug) {
                     std::cout << "RIT is full." << std::endl;
                     std::cout << "Unswapping row " << unswap_pair.first << " with row " << unswap_pair.second << std::endl;
@@ -312,7 +253,7 @@ class RRS : public IControllerPlugin, public Implementation {
               // check if rit has empty slots
               if (m_addr_mapper->is_rit_full(flat_bank_id)) {
                 // if rit is full, get a pair to unswap
-                auto unswap_pair = m_addr_mapper->get_unswap_pair(flat_bank_id, m_hot_row_tracker[flat_bank_id]);
+                auto unswap_pair = m_addr_mapper->get_unswap_pair(flat_bank_id, [&](int row) { return m_hot_row_tracker.contains(flat_bank_id, row); });
                 if (m_is_debug) {
                   std::cout << "RIT is full." << std::endl;
                   std::cout << "Unswapping row " << unswap_pair.first << " with row " << unswap_pair.second << std::endl;
@@ -350,9 +291,9 @@ class RRS : public IControllerPlugin, public Implementation {
       // find a row to swap with
       int dst_row = -1;
       while (dst_row == -1) {
-        int rand_row = distribution(generator);
+        int rand_row = m_rng.uniform_int(0, m_num_rows_per_bank - 1);
         // check if rand row is in hrt or is in rit or is not row_id 
-        if (m_hot_row_tracker[bank_id].find(rand_row) == m_hot_row_tracker[bank_id].end() 
+        if (!m_hot_row_tracker.contains(bank_id, rand_row) 
             && m_addr_mapper->check_rit(bank_id, rand_row) == -1
             && rand_row != row_id) {
           dst_row = rand_row;
@@ -362,55 +303,7 @@ class RRS : public IControllerPlugin, public Implementation {
     }
 
     void issue_swap(ReqBuffer::iterator& req_it, int src_row, int dst_row) {
-      // load addr_vec
-      std::vector<int> addr_vec;
-      for (int i = 0; i < req_it->addr_vec.size(); i++){
-        addr_vec.push_back(req_it->addr_vec[i]);
-      }
-
-      // Read src_row to buffer0 
-      addr_vec[m_row_level] = src_row;
-      for (int cl = 0; cl < m_num_cls; cl++){
-        addr_vec[m_col_level] = cl << 3;
-        Request swap_read_req(addr_vec, m_RD_req_id);
-        if (!m_ctrl->priority_send(swap_read_req)){
-          std::cerr << "Check priority queue max size." << std::endl;
-          exit(1);
-        }
-      }
-
-      // Read dst_row to buffer1
-      addr_vec[m_row_level] = dst_row;
-      for (int cl = 0; cl < m_num_cls; cl++){
-        addr_vec[m_col_level] = cl << 3;
-        Request swap_read_req(addr_vec, m_RD_req_id);
-        if (!m_ctrl->priority_send(swap_read_req)){
-          std::cerr << "Check priority queue max size." << std::endl;
-          exit(1);
-        }
-      }
-
-      // Write buffer0 to dst_row
-      addr_vec[m_row_level] = dst_row;
-      for (int cl = 0; cl < m_num_cls; cl++){
-        addr_vec[m_col_level] = cl << 3;
-        Request swap_write_req(addr_vec, m_WR_req_id);
-        if (!m_ctrl->priority_send(swap_write_req)){
-          std::cerr << "Check priority queue max size." << std::endl;
-          exit(1);
-        }
-      }
-
-      // Write buffer1 to src_row
-      addr_vec[m_row_level] = src_row;
-      for (int cl = 0; cl < m_num_cls; cl++){
-        addr_vec[m_col_level] = cl << 3;
-        Request swap_write_req(addr_vec, m_WR_req_id);
-        if (!m_ctrl->priority_send(swap_write_req)){
-          std::cerr << "Check priority queue max size." << std::endl;
-          exit(1);
-        }
-      }
+      m_swap_engine.enqueue_swap(req_it->addr_vec, src_row, dst_row);
     }
 
 };
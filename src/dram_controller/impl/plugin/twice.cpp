@@ -1,11 +1,12 @@
 #include <vector>
-#include <unordered_map>
 #include <limits>
 #include <random>
 
 #include "base/base.h"
 #include "dram_controller/controller.h"
 #include "dram_controller/plugin.h"
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
+#include "dram_controller/impl/plugin/row_counter_table/row_counter_table.h"
 
 namespace Ramulator {
 
@@ -24,10 +25,9 @@ class TWiCeIdeal : public IControllerPlugin, public Implementation {
         act_count(a), life(l) {};
     };
 
-    Clk_t m_clk = 0;
-
     int m_twice_rh_threshold = -1;
     float m_twice_pruning_interval_threshold = -1;
+    int m_twice_table_capacity = -1;
     bool m_is_debug = false;
 
     int m_VRR_req_id = -1;
@@ -44,13 +44,24 @@ class TWiCeIdeal : public IControllerPlugin, public Implementation {
     // indexed using flattened <rank id, bank id>
     // e.g., if rank 0, bank 4, index is 4
     // if rank 1, bank 5, index is 16 (assuming 16 banks/rank) + 5
-    std::vector<std::unordered_map<Addr_t, TwiCeEntry>> m_twice_table;
+    RowCounterTable<TwiCeEntry> m_twice_table;
+
+    size_t s_num_table_overflows = 0;
+
+    MitigationStats m_mitigation;
 
   public:
     void init() override { 
       m_twice_rh_threshold = param<int>("twice_rh_threshold").required();
       m_twice_pruning_interval_threshold = param<float>("twice_pruning_interval_threshold").required();
+      m_twice_table_capacity = param<int>("twice_table_capacity").desc("Maximum number of rows tracked per bank").default_val(8192);
       m_is_debug = param<bool>("debug").default_val(false);
+
+      subscribe_commands(OpeningCommands | RefreshingCommands);
+
+      register_stat(s_num_table_overflows).name("twice_num_table_overflows").desc("Number of ACTs to untracked rows when the table is full");
+      m_mitigation.register_stats(this);
+      m_mitigation_stats = &m_mitigation;
     };
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
@@ -74,16 +85,10 @@ class TWiCeIdeal : public IControllerPlugin, public Implementation {
       m_num_rows_per_bank = m_dram->get_level_size("row");
 
       // Initialize twice table
-      for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-        std::unordered_map<Addr_t, TwiCeEntry> bank_twice_table;
-        m_twice_table.push_back(bank_twice_table);
-      }
+      m_twice_table.init(m_num_ranks * m_num_banks_per_rank, m_twice_table_capacity);
     };
 
     void update(bool request_found, ReqBuffer::iterator& req_it) override {
-
-      m_clk++;
-
       if (request_found) {
         if (m_dram->m_command_meta(req_it->command).is_refreshing && m_dram->m_command_scopes(req_it->command) == m_rank_level) {
           // Refresh command
@@ -92,25 +97,21 @@ class TWiCeIdeal : public IControllerPlugin, public Implementation {
             std::cout << "TWiCeIdeal: Refresh command" << std::endl;
           }
           for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-            std::vector<std::unordered_map<Addr_t, TwiCeEntry>::iterator> to_be_pruned;
-            for (auto it = m_twice_table[i].begin(); it != m_twice_table[i].end(); it++) {
-              if (it->second.act_count < it->second.life * m_twice_pruning_interval_threshold) {
-                // Store the entries to be pruned
-                to_be_pruned.emplace_back(it);
-                if (m_is_debug) {
-                  std::cout << "TWiCeIdeal: Pruned entry " << it->first << " from bank " << i << std::endl;
-                }
-              } else {
-                // Increment the life of the entry
-                it->second.life++;
+            m_twice_table.erase_if(i, [this, i](int row_id, TwiCeEntry& entry) {
+              if (entry.act_count < entry.life * m_twice_pruning_interval_threshold) {
+                // Prune the entry
                 if (m_is_debug) {
-                  std::cout << "TWiCeIdeal: Incremented life of entry " << it->first << " in bank " << i << std::endl;
+                  std::cout << "TWiCeIdeal: Pruned entry " << row_id << " from bank " << i << std::endl;
                 }
+                return true;
               }
-            }
-            for (auto&& it : to_be_pruned) {
-              m_twice_table[i].erase(it);
-            }
+              // Increment the life of the entry
+              entry.life++;
+              if (m_is_debug) {
+                std::cout << "TWiCeIdeal: Incremented life of entry " << row_id << " in bank " << i << std::endl;
+              }
+              return false;
+            });
           }
         } else if (m_dram->m_command_meta(req_it->command).is_opening && m_dram->m_command_scopes(req_it->command) == m_row_level) {
           // Activation command
@@ -131,24 +132,25 @@ class TWiCeIdeal : public IControllerPlugin, public Implementation {
             std::cout << "  └  " << "index: " << flat_bank_id << std::endl;
           }
 
-          if (m_twice_table[flat_bank_id].find(row_id) == m_twice_table[flat_bank_id].end()){
+          TwiCeEntry* entry = m_twice_table.find(flat_bank_id, row_id);
+          if (!entry) {
             // If row is not in the table, insert it
-            m_twice_table[flat_bank_id].insert(std::make_pair(row_id, TwiCeEntry(1, 0)));
-            
-            if (m_is_debug) {
+            if (!m_twice_table.insert(flat_bank_id, row_id, TwiCeEntry(1, 0))) {
+              s_num_table_overflows++;
+            } else if (m_is_debug) {
               std::cout << "TWiCeIdeal: Inserted row " << row_id << " into bank " << flat_bank_id << std::endl;
             }
           } else {
             // If row is in the table, increment the act count
-            m_twice_table[flat_bank_id][row_id].act_count++;
+            entry->act_count++;
 
-            if (m_twice_table[flat_bank_id][row_id].act_count >= m_twice_rh_threshold) {
+            if (entry->act_count >= m_twice_rh_threshold) {
               // If the act count is greater than the threshold, issue a VRR
               Request vrr_req(req_it->addr_vec, m_VRR_req_id);
+              m_mitigation.tag(vrr_req);
               m_ctrl->priority_send(vrr_req);
 
-              auto it = m_twice_table[flat_bank_id].find(row_id);
-              m_twice_table[flat_bank_id].erase(it);
+              m_twice_table.erase(flat_bank_id, row_id);
 
               if (m_is_debug) {
                 std::cout << "TWiCeIdeal: VRR on row " << row_id << std::endl;
@@ -0,0 +1,191 @@
+#include <vector>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/power_manager.h"
+
+namespace Ramulator {
+
+/**
+ * @brief   Puts idle ranks into power-down and, after a longer idle period, self-refresh.
+ * @details
+ * A rank is idle since the last command issued for a demand request to it (refreshes and other maintenance do not
+ * count). Under the "timeout" entry policy, the rank enters power-down (self-refresh) once it has been idle for
+ * pd_timeout (sr_timeout) cycles. The "queue_aware" entry policy additionally keeps the rank powered up as long as
+ * demand requests to it are waiting in the controller.
+ *
+ * PDE/SRE are sent through the priority buffer, and only when they can be issued right away, so that they do not
+ * hold back other maintenance requests. The exit is on demand: the first command to a powered-down (self-refreshing)
+ * rank is preceded by a PDX (SRX), and the DRAM timings (nXP/nXS) delay the commands after it.
+ */
+class IdlePowerManager : public IPowerManager, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IPowerManager, IdlePowerManager, "Idle", "Idle-timeout driven power-down and self-refresh entry.")
+  private:
+    enum class RankState { UP, ENTERING_PD, PD, ENTERING_SR, SR };
+
+    IDRAM* m_dram = nullptr;
+    IDRAMController* m_ctrl = nullptr;
+
+    int m_pd_timeout = -1;
+    int m_sr_timeout = -1;
+    bool m_is_queue_aware = false;
+
+    int m_rank_level = -1;
+    int m_num_ranks = -1;
+    int m_dram_org_levels = -1;
+
+    int m_PDE_req_id = -1;
+    int m_SRE_req_id = -1;
+    int m_PDE_cmd = -1;
+    int m_PDX_cmd = -1;
+    int m_SRE_cmd = -1;
+    int m_SRX_cmd = -1;
+
+    std::vector<RankState> m_states;         // [rank]
+    std::vector<Clk_t> m_last_demand_clk;    // [rank], the last cycle a command was issued for a demand request
+    std::vector<Clk_t> m_low_power_start;    // [rank], the cycle the rank entered its current low-power state
+    std::vector<int> m_low_power_cmd;        // [rank], the command (PDE/SRE) that put the rank into it, or -1
+    std::vector<int> m_num_queued;           // [rank], the number of demand requests waiting in the controller
+
+    size_t s_num_pd_entries = 0;
+    size_t s_num_sr_entries = 0;
+    size_t s_pd_cycles = 0;
+    size_t s_sr_cycles = 0;
+
+  public:
+    void init() override {
+      m_ctrl = cast_parent<IDRAMController>();
+
+      m_pd_timeout = param<int>("pd_timeout").desc("Idle cycles before a rank enters power-down (-1 disables power-down).").default_val(-1);
+      m_sr_timeout = param<int>("sr_timeout").desc("Idle cycles before a rank enters self-refresh (-1 disables self-refresh).").default_val(-1);
+      std::string entry_policy = param<std::string>("entry_policy").desc("\"timeout\" or \"queue_aware\" (also waits for the queued requests to the rank).").default_val("timeout");
+
+      if (entry_policy == "queue_aware") {
+        m_is_queue_aware = true;
+      } else if (entry_policy != "timeout") {
+        throw ConfigurationError("[IdlePowerManager] Unknown entry_policy \"{}\"!", entry_policy);
+      }
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_dram = m_ctrl->m_dram;
+
+      for (auto cmd_name : {"PDE", "PDX", "SRE", "SRX"}) {
+        if (!m_dram->m_commands.contains(cmd_name)) {
+          throw ConfigurationError("[IdlePowerManager] Command {} does not exist.", cmd_name);
+        }
+      }
+      m_PDE_req_id = m_dram->m_requests("power-down");
+      m_SRE_req_id = m_dram->m_requests("self-refresh");
+      m_PDE_cmd = m_dram->m_commands("PDE");
+      m_PDX_cmd = m_dram->m_commands("PDX");
+      m_SRE_cmd = m_dram->m_commands("SRE");
+      m_SRX_cmd = m_dram->m_commands("SRX");
+
+      m_rank_level = m_dram->m_levels("rank");
+      m_num_ranks = m_dram->get_level_size("rank");
+      m_dram_org_levels = m_dram->m_levels.size();
+
+      m_states.assign(m_num_ranks, RankState::UP);
+      m_last_demand_clk.assign(m_num_ranks, 0);
+      m_low_power_start.assign(m_num_ranks, 0);
+      m_low_power_cmd.assign(m_num_ranks, -1);
+      m_num_queued.assign(m_num_ranks, 0);
+
+      register_stat(s_num_pd_entries).name("num_pd_entries_{}", m_ctrl->m_channel_id);
+      register_stat(s_num_sr_entries).name("num_sr_entries_{}", m_ctrl->m_channel_id);
+      register_stat(s_pd_cycles).name("pd_cycles_{}", m_ctrl->m_channel_id);
+      register_stat(s_sr_cycles).name("sr_cycles_{}", m_ctrl->m_channel_id);
+    };
+
+    void on_enqueue(const Request& req) override {
+      m_num_queued[req.addr_vec[m_rank_level]]++;
+    };
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) override {
+      Clk_t clk = m_ctrl->get_clk();
+      if (request_found) {
+        process_command(clk, *req_it);
+      }
+
+      for (int r = 0; r < m_num_ranks; r++) {
+        if (m_is_queue_aware && m_num_queued[r] > 0) {
+          continue;
+        }
+        Clk_t idle_cycles = clk - m_last_demand_clk[r];
+        if ((m_states[r] == RankState::UP || m_states[r] == RankState::PD) &&
+            m_sr_timeout != -1 && idle_cycles >= m_sr_timeout) {
+          // A powered-down rank is woken up by the preq of SRE first
+          try_send(r, m_SRE_req_id, RankState::ENTERING_SR);
+        } else if (m_states[r] == RankState::UP && m_pd_timeout != -1 && idle_cycles >= m_pd_timeout) {
+          try_send(r, m_PDE_req_id, RankState::ENTERING_PD);
+        }
+      }
+    };
+
+    bool is_self_refreshing(int rank_id) override {
+      return m_states[rank_id] == RankState::ENTERING_SR || m_states[rank_id] == RankState::SR;
+    };
+
+    void finalize() override {
+      for (int r = 0; r < m_num_ranks; r++) {
+        leave_low_power(m_ctrl->get_clk(), r);
+      }
+    };
+
+  private:
+    void process_command(Clk_t clk, const Request& req) {
+      int rank_id = req.addr_vec[m_rank_level];
+      if (rank_id == -1) {
+        return;
+      }
+
+      // Demand requests have an arrival time, maintenance requests from the priority buffer do not
+      if (req.arrive != -1) {
+        m_last_demand_clk[rank_id] = clk;
+        if (req.command == req.final_command) {
+          m_num_queued[rank_id]--;
+        }
+      }
+
+      if (req.command == m_PDE_cmd || req.command == m_SRE_cmd) {
+        bool is_pd = req.command == m_PDE_cmd;
+        m_states[rank_id] = is_pd ? RankState::PD : RankState::SR;
+        m_low_power_start[rank_id] = clk;
+        m_low_power_cmd[rank_id] = req.command;
+        (is_pd ? s_num_pd_entries : s_num_sr_entries)++;
+      } else if (req.command == m_PDX_cmd || req.command == m_SRX_cmd) {
+        leave_low_power(clk, rank_id);
+        // A PDX on the way to self-refresh keeps the rank entering self-refresh
+        if (m_states[rank_id] != RankState::ENTERING_SR) {
+          m_states[rank_id] = RankState::UP;
+        }
+      }
+    };
+
+    void leave_low_power(Clk_t clk, int rank_id) {
+      if (m_low_power_cmd[rank_id] == m_PDE_cmd) {
+        s_pd_cycles += clk - m_low_power_start[rank_id];
+      } else if (m_low_power_cmd[rank_id] == m_SRE_cmd) {
+        s_sr_cycles += clk - m_low_power_start[rank_id];
+      }
+      m_low_power_cmd[rank_id] = -1;
+    };
+
+    void try_send(int rank_id, int req_id, RankState next_state) {
+      AddrVec_t addr_vec(m_dram_org_levels, -1);
+      addr_vec[0] = m_ctrl->m_channel_id;
+      addr_vec[m_rank_level] = rank_id;
+
+      int cmd = m_dram->m_request_translations(req_id);
+      if (!m_dram->check_ready(m_dram->get_preq_command(cmd, addr_vec), addr_vec)) {
+        return;
+      }
+      Request req(addr_vec, req_id);
+      if (m_ctrl->priority_send(req)) {
+        m_states[rank_id] = next_state;
+      }
+    };
+};
+
+}       // namespace Ramulator
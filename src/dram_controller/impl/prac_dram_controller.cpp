@@ -5,6 +5,9 @@
 #include "frontend/impl/processor/bhO3/bhO3.h"
 
 #include "dram_controller/impl/plugin/prac/prac.h"
+#include "dram_controller/impl/plugin/plugin_dispatcher/plugin_dispatcher.h"
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
+#include "dram_controller/impl/latency_stats/latency_stats.h"
 
 namespace Ramulator {
 
@@ -24,6 +27,10 @@ private:
     ReqBuffer m_priority_buffer;          // Buffer for high-priority requests (e.g., maintenance like refresh).
     ReqBuffer m_read_buffer;              // Read request buffer
     ReqBuffer m_write_buffer;             // Write request buffer
+
+    PluginDispatcher m_plugin_dispatcher; // Calls the plugins on the cycles they subscribed to
+    MitigationAccounting m_mitigation_accounting; // Attributes the cost of the RowHammer mitigations to them
+    LatencyStats m_latency_stats;         // Latency histograms of the demand requests
     ReqBuffer m_prac_buffer;              // Custom PRAC buffer
     
     Request* m_prea_template;
@@ -58,6 +65,9 @@ public:
         m_scheduler = create_child_ifce<IBHScheduler>();
         m_refresh = create_child_ifce<IRefreshManager>();
         m_rowpolicy = create_child_ifce<IRowPolicy>();
+        if (m_config["PowerManager"]) {
+            m_power_manager = create_child_ifce<IPowerManager>();
+        }
         m_logger = Logging::create_logger("DBHCTRL");
 
         if (m_config["plugins"]) {
@@ -78,6 +88,8 @@ public:
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
         m_llc = static_cast<BHO3*>(frontend)->get_llc();
         m_dram = memory_system->get_ifce<IDRAM>();
+        m_plugin_dispatcher.init(m_dram, m_plugins);
+        m_mitigation_accounting.init(m_dram, m_plugins, {&m_active_buffer, &m_read_buffer});
         m_rank_addr_idx = m_dram->m_levels("rank");
         m_bankgroup_addr_idx = m_dram->m_levels("bankgroup");
         m_bank_addr_idx = m_dram->m_levels("bank");
@@ -96,6 +108,12 @@ public:
         m_rfmab_template = new Request(all_bank_addr_vec, m_dram->m_requests("rfm"));
         m_rfmab_template->command = m_rfmab_id;
         m_rfmab_template->final_command = m_rfmab_id;
+
+        // The ABO recovery is a cost of PRAC
+        if (auto mitigation = dynamic_cast<IControllerPlugin*>(m_prac)->get_mitigation_stats()) {
+            mitigation->tag(*m_prea_template);
+            mitigation->tag(*m_rfmab_template);
+        }
         
         int num_cores = static_cast<BHO3*>(frontend)->get_num_cores();
         s_core_row_hits.resize(num_cores);
@@ -113,6 +131,7 @@ public:
         register_stat(s_num_row_hits).name("controller_num_row_hits");
         register_stat(s_num_row_misses).name("controller_num_row_misses");
         register_stat(s_num_row_conflicts).name("controller_num_row_conflicts");
+        m_latency_stats.register_stats(this, m_channel_id, num_cores);
     };
 
     bool send(Request& req) override {
@@ -146,6 +165,9 @@ public:
             req.arrive = -1;
             return false;
         }
+        if (m_power_manager) {
+            m_power_manager->on_enqueue(req);
+        }
 
         return true;
     };
@@ -191,14 +213,20 @@ public:
         // RowPolicy
         m_rowpolicy->update(request_found, req_it);
 
-        // Update all plugins
-        for (auto plugin : m_plugins) {
-            plugin->update(request_found, req_it);
+        // PowerManager
+        if (m_power_manager) {
+            m_power_manager->update(request_found, req_it);
         }
 
+        // Update all plugins
+        m_plugin_dispatcher.update(m_clk, request_found, req_it);
+        m_mitigation_accounting.update(m_clk, request_found, req_it);
+
         // Issue the commands to serve the request
         if (request_found) {
             m_dram->issue_command(req_it->command, req_it->addr_vec);
+            m_scheduler->on_command_issued(req_it->command, req_it->addr_vec);
+            m_latency_stats.on_command(m_clk, *req_it);
 
             // If we are issuing the last command, set depart clock cycle and move the request to the pending queue
             if (req_it->command == req_it->final_command) {
@@ -207,7 +235,8 @@ public:
                     pending.push_back(*req_it);
                 }
                 else if (req_it->type_id == Request::Type::Write) {
-                    // TODO: Add code to update statistics
+                    req_it->depart = m_clk + 1;
+                    m_latency_stats.on_depart(*req_it);
                 }
                 buffer->remove(req_it);
             }
@@ -236,7 +265,7 @@ private:
                 // Request received data from dram
                 if (req.depart - req.arrive > 1) {
                     // Check if this requests accesses the DRAM or is being forwarded.
-                    // TODO add the stats back
+                    m_latency_stats.on_depart(req);
                 }
 
                 if (req.callback) {
@@ -366,6 +395,7 @@ private:
     }
 
     void finalize() override {
+        m_mitigation_accounting.finalize();
     }
 };
 }   // namespace Ramulator
@@ -43,6 +43,10 @@ class AllBankRefresh : public IRefreshManager, public Implementation {
       if (m_clk == m_next_refresh_cycle) {
         m_next_refresh_cycle += m_nrefi;
         for (int r = 0; r < m_num_ranks; r++) {
+          // A self-refreshing rank refreshes itself
+          if (m_ctrl->m_power_manager && m_ctrl->m_power_manager->is_self_refreshing(r)) {
+            continue;
+          }
           std::vector<int> addr_vec(m_dram_org_levels, -1);
           addr_vec[0] = m_ctrl->m_channel_id;
           addr_vec[1] = r;
@@ -23,6 +23,15 @@ class BLISSScheduler : public IBHScheduler, public Implementation {
 
     const int SAFE_IDX = 0;
     const int READY_IDX = 1;
+    const int EPOCH_IDX = 2;
+    const int MASK_EPOCH_IDX = 3;
+
+    // As in the PRAC scheduler, the command and a true ready flag of a request are cached until the DRAM state
+    // or timing changes. Whether a request is safe only depends on the blacklist, so it is cached until it changes.
+    SchedulerEpoch m_epoch;
+    size_t m_num_future_actions = 0;
+    SchedulerEpoch m_mask_epoch;
+    uint64_t m_blacklist_mask = 0;
 
   public:
     void init() override { }
@@ -76,18 +85,31 @@ class BLISSScheduler : public IBHScheduler, public Implementation {
         return buffer.end();
       }
 
-      for (auto& req : buffer) {
-        req.command = m_dram->get_preq_command(req.final_command, req.addr_vec);
+      if (m_dram->m_future_actions.size() != m_num_future_actions) {
+        m_num_future_actions = m_dram->m_future_actions.size();
+        m_epoch.advance();
+      }
+      if (m_bliss->get_blacklist_mask() != m_blacklist_mask) {
+        m_blacklist_mask = m_bliss->get_blacklist_mask();
+        m_mask_epoch.advance();
+      }
 
+      for (auto& req : buffer) {
         // Check if the request is safe to issue
-        bool blisted = m_bliss->is_blacklisted(req.source_id);
-        bool isrw = req.type_id == m_req_rd || req.type_id == m_req_wr;
-        bool safe = !isrw || !blisted;
-        req.scratchpad[SAFE_IDX] = safe;
-        
+        if (m_mask_epoch.retag(req, MASK_EPOCH_IDX)) {
+          bool blisted = req.source_id < 0 || (m_blacklist_mask >> req.source_id) & 1;
+          bool isrw = req.type_id == m_req_rd || req.type_id == m_req_wr;
+          req.scratchpad[SAFE_IDX] = !isrw || !blisted;
+        }
+
         // Check if the request is ready
-        bool ready = m_dram->check_ready(req.command, req.addr_vec);
-        req.scratchpad[READY_IDX] = ready;
+        if (m_epoch.retag(req, EPOCH_IDX)) {
+          req.command = m_dram->get_preq_command(req.final_command, req.addr_vec);
+          req.scratchpad[READY_IDX] = m_dram->check_ready(req.command, req.addr_vec);
+        } else if (!req.scratchpad[READY_IDX]) {
+          // Timing constraints only expire as time passes, so only a command that was not ready is checked again
+          req.scratchpad[READY_IDX] = m_dram->check_ready(req.command, req.addr_vec);
+        }
       }
 
       auto candidate = buffer.begin();
@@ -97,6 +119,10 @@ class BLISSScheduler : public IBHScheduler, public Implementation {
       return candidate;
     }
 
+    void on_command_issued(int command, const AddrVec_t& addr_vec) override {
+      m_epoch.advance();
+    }
+
     virtual void tick() override {
       m_clk++;
     }
@@ -4,6 +4,7 @@
 #include "dram_controller/bh_controller.h"
 #include "dram_controller/bh_scheduler.h"
 #include "dram_controller/impl/plugin/blockhammer/blockhammer.h"
+#include "dram_controller/impl/plugin/mitigation_accounting/mitigation_accounting.h"
 
 namespace Ramulator {
 
@@ -13,6 +14,7 @@ class BlockingScheduler : public IBHScheduler, public Implementation {
   private:
     IDRAM* m_dram;
     IBlockHammer* m_bh;
+    MitigationStats* m_mitigation = nullptr;
 
     int m_clk = -1;
 
@@ -32,6 +34,7 @@ class BlockingScheduler : public IBHScheduler, public Implementation {
         std::cout << "BlockHammer scheduler requires BlockHammer plugin enabled!" << std::endl;
         std::exit(0); 
       }
+      m_mitigation = dynamic_cast<IControllerPlugin*>(m_bh)->get_mitigation_stats();
     }
 
     ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) override {
@@ -63,21 +66,20 @@ class BlockingScheduler : public IBHScheduler, public Implementation {
         req.command = m_dram->get_preq_command(req.final_command, req.addr_vec);
       }
 
-      auto candidate = buffer.begin();
-      while (candidate != buffer.end() && !m_bh->is_act_safe(*candidate)) {
-        candidate++;
-      }
-
-      if (candidate == buffer.end()) {
-        return buffer.end();
-      }
-
-      // std::next(candidate, 1)
-      for (auto next = std::next(buffer.begin(), 1); next != buffer.end(); next++) {
+      // Every demand read that is throttled in this cycle is delayed by one cycle
+      auto candidate = buffer.end();
+      int num_throttled_reads = 0;
+      for (auto next = buffer.begin(); next != buffer.end(); next++) {
         if (!m_bh->is_act_safe(*next)) {
+          if (next->type_id == Request::Type::Read) {
+            num_throttled_reads++;
+          }
           continue;
         }
-        candidate = compare(candidate, next);
+        candidate = candidate == buffer.end() ? next : compare(candidate, next);
+      }
+      if (m_mitigation) {
+        m_mitigation->add_demand_read_delay(num_throttled_reads);
       }
       return candidate;
     }
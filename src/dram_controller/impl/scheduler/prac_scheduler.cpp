@@ -23,6 +23,13 @@ private:
 
     const int FITS_IDX = 0;
     const int READY_IDX = 1;
+    const int MIN_CYCLES_IDX = 2;
+    const int EPOCH_IDX = 3;
+
+    // The command, its minimum cycles, and a true ready flag of a request are cached until the DRAM state or
+    // timing changes, i.e., a command is issued or a future action (e.g., the end of a refresh) is handled.
+    SchedulerEpoch m_epoch;
+    size_t m_num_future_actions = 0;
 
 public:
     void init() override {
@@ -78,11 +85,23 @@ public:
             return buffer.end();
         }
 
+        if (m_dram->m_future_actions.size() != m_num_future_actions) {
+            m_num_future_actions = m_dram->m_future_actions.size();
+            m_epoch.advance();
+        }
+
         Clk_t next_recovery = m_prac->next_recovery_cycle();
         for (auto& req : buffer) {
-            req.command = m_dram->get_preq_command(req.final_command, req.addr_vec);
-            req.scratchpad[FITS_IDX] = m_clk + m_prac->min_cycles_with_preall(req) < next_recovery;
-            req.scratchpad[READY_IDX] = m_dram->check_ready(req.command, req.addr_vec);
+            if (m_epoch.retag(req, EPOCH_IDX)) {
+                req.command = m_dram->get_preq_command(req.final_command, req.addr_vec);
+                req.scratchpad[MIN_CYCLES_IDX] = m_prac->min_cycles_with_preall(req);
+                req.scratchpad[READY_IDX] = m_dram->check_ready(req.command, req.addr_vec);
+            } else if (!req.scratchpad[READY_IDX]) {
+                // Timing constraints only expire as time passes, so only a command that was not ready is checked again
+                req.scratchpad[READY_IDX] = m_dram->check_ready(req.command, req.addr_vec);
+            }
+            // The next recovery moves with the ABO state, so this is not cached
+            req.scratchpad[FITS_IDX] = m_clk + req.scratchpad[MIN_CYCLES_IDX] < next_recovery;
         }
 
         auto candidate = buffer.begin();
@@ -92,6 +111,10 @@ public:
         return candidate;
     }
 
+    void on_command_issued(int command, const AddrVec_t& addr_vec) override {
+        m_epoch.advance();
+    }
+
     virtual void tick() override {
         m_clk++;
     }
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include <functional>
 
 #include "base/base.h"
 
@@ -10,14 +11,63 @@
 namespace Ramulator {
 
 class IDRAMController;
+class PluginDispatcher;
+class MitigationStats;
 
 class IControllerPlugin {
   RAMULATOR_REGISTER_INTERFACE(IControllerPlugin, "ControllerPlugin", "Plugins for the memory controller.");
+  friend class PluginDispatcher;
+
+  public:
+    /**
+     * @brief   Classes of DRAM commands (see DRAMCommandMeta) a plugin can subscribe to.
+     */
+    enum CommandClass : uint32_t {
+      OpeningCommands    = 1 << 0,
+      ClosingCommands    = 1 << 1,
+      AccessingCommands  = 1 << 2,
+      RefreshingCommands = 1 << 3,
+      AllCommands        = ~0u,
+    };
+
   protected:
     IDRAMController* m_ctrl = nullptr;
 
+    struct Timer {
+      Clk_t period;
+      Clk_t offset;
+      std::function<void()> callback;
+    };
+
+    bool m_is_subscribed = false;     // Plugins that do not subscribe to anything are updated every cycle
+    uint32_t m_command_classes = 0;
+    std::vector<Timer> m_timers;
+
+    MitigationStats* m_mitigation_stats = nullptr;   // Set by RowHammer mitigations to account for their cost
+
+    /**
+     * @brief   Only call update() on the cycles that issue a command of the given classes (call in init() or setup()).
+     */
+    void subscribe_commands(uint32_t command_classes) {
+      m_is_subscribed = true;
+      m_command_classes |= command_classes;
+    };
+
+    /**
+     * @brief   Call callback on the controller cycles where clk % period == offset, before update() (call in init() or setup()).
+     */
+    void subscribe_timer(Clk_t period, std::function<void()> callback, Clk_t offset = 0) {
+      m_is_subscribed = true;
+      m_timers.push_back({period, offset, std::move(callback)});
+    };
+
   public:
     virtual void update(bool request_found, ReqBuffer::iterator& req_it) = 0;
+
+    /**
+     * @brief   Returns the cost accounting of the plugin, or nullptr if it is not a RowHammer mitigation.
+     */
+    MitigationStats* get_mitigation_stats() { return m_mitigation_stats; };
 };
 
 }        // namespace Ramulator
@@ -0,0 +1,35 @@
+#ifndef     RAMULATOR_CONTROLLER_POWERMANAGER_H
+#define     RAMULATOR_CONTROLLER_POWERMANAGER_H
+
+#include <vector>
+#include <string>
+
+#include "base/base.h"
+
+
+namespace Ramulator {
+
+class IPowerManager {
+  RAMULATOR_REGISTER_INTERFACE(IPowerManager, "PowerManager", "Power Manager Interface (power-down and self-refresh entry).");
+
+  public:
+    /**
+     * @brief   Called by the controller after a demand request is enqueued.
+     */
+    virtual void on_enqueue(const Request& req) = 0;
+
+    /**
+     * @brief   Called by the controller every cycle after a request is scheduled (before its command is issued).
+     */
+    virtual void update(bool request_found, ReqBuffer::iterator& req_it) = 0;
+
+    /**
+     * @brief   Whether the rank is in (or entering) self-refresh, so that it does not need periodic refreshes.
+     */
+    virtual bool is_self_refreshing(int rank_id) = 0;
+};
+
+}        // namespace Ramulator
+
+
+#endif   // RAMULATOR_CONTROLLER_POWERMANAGER_H
\ No newline at end of file
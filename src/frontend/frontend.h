@@ -36,6 +36,11 @@ class IFrontEnd : public Clocked<IFrontEnd>, public TopLevel<IFrontEnd> {
         component->finalize();
       }
 
+      if (StatsSink* sink = StatsSink::get()) {
+        m_impl->write_stats(*sink);
+        return;
+      }
+
       YAML::Emitter emitter;
       emitter << YAML::BeginMap;
       m_impl->print_stats(emitter);
@@ -55,7 +60,7 @@ class IFrontEnd : public Clocked<IFrontEnd>, public TopLevel<IFrontEnd> {
      * (tries to) send to the memory system, and return if this is successful
      * 
      */
-    virtual bool receive_external_requests(int req_type_id, Addr_t addr, int source_id, std::function<void(Request&)> callback) { return false; }
+    virtual bool receive_external_requests(int req_type_id, Addr_t addr, int source_id, RequestCallback callback) { return false; }
 };
 
 }        // namespace Ramulator
@@ -0,0 +1,293 @@
+#include <filesystem>
+#include <iostream>
+#include <fstream>
+#include <unordered_map>
+#include <algorithm>
+#include <bit>
+
+#include "frontend/frontend.h"
+#include "translation/translation.h"
+#include "addr_mapper/addr_mapper.h"
+#include "dram/dram.h"
+#include "base/exception.h"
+
+namespace Ramulator {
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief   Streams a trace through the translation and address mapper of the configuration without simulating the DRAM.
+ * @details
+ * Reports channel/rank/bank load balance, the row-buffer locality of an ideal open-page policy per bank,
+ * a histogram of the distance (in accesses) between a row conflict and the previous access to the same bank,
+ * and the most frequently accessed rows. The simulation finishes in the first tick.
+ */
+class AddrMapAnalyzer : public IFrontEnd, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IFrontEnd, AddrMapAnalyzer, "AddrMapAnalyzer", "Offline address mapping quality analyzer.")
+
+  private:
+    std::string m_trace_path;
+    std::string m_trace_format;
+    int m_num_hot_rows = -1;
+    int m_num_distance_bins = -1;
+
+    ITranslation* m_translation = nullptr;
+    IAddrMapper* m_addr_mapper = nullptr;
+    IDRAM* m_dram = nullptr;
+
+    int m_channel_level = -1;
+    int m_rank_level = -1;     // The rank level, or the pseudochannel level for standards without ranks (-1 if neither)
+    int m_row_level = -1;
+    int m_num_ranks = -1;      // Total number of ranks in the system
+    int m_num_banks = -1;      // Total number of banks in the system
+
+    bool m_is_finished = false;
+
+    struct BankState {
+      int open_row = -1;
+      size_t last_access = 0;
+    };
+    std::vector<BankState> m_bank_states;
+    std::unordered_map<uint64_t, size_t> m_row_accesses;   // (flat bank id, row) -> number of accesses
+
+    size_t s_num_accesses = 0;
+    size_t s_num_reads = 0;
+    size_t s_num_writes = 0;
+
+    std::vector<size_t> s_channel_accesses;
+    std::vector<size_t> s_rank_accesses;
+    std::vector<size_t> s_bank_accesses;
+    double s_channel_imbalance = 0.0;
+    double s_rank_imbalance = 0.0;
+    double s_bank_imbalance = 0.0;
+
+    size_t s_row_hits = 0;
+    size_t s_row_misses = 0;
+    size_t s_row_conflicts = 0;
+    double s_row_hit_rate = 0.0;
+    std::vector<size_t> s_bank_row_hits;
+    std::vector<double> s_bank_row_hit_rate;
+
+    std::vector<size_t> s_conflict_distance;
+    std::vector<std::string> s_hot_rows;
+
+    Logger_t m_logger;
+
+  public:
+    void init() override {
+      m_trace_path = param<std::string>("path").desc("Path to the trace file.").required();
+      m_trace_format = param<std::string>("format").desc("Trace format, \"LoadStore\" (LD/ST <addr>) or \"SimpleO3\" (<bubbles> <load addr> [<writeback addr>]).").default_val("LoadStore");
+      if (m_trace_format != "LoadStore" && m_trace_format != "SimpleO3") {
+        throw ConfigurationError("Unknown trace format \"{}\" for AddrMapAnalyzer!", m_trace_format);
+      }
+      m_num_hot_rows = param<int>("num_hot_rows").desc("Number of the most accessed rows to report.").default_val(16);
+      m_num_distance_bins = param<int>("num_distance_bins").desc("Number of log2 bins of the conflict distance histogram.").default_val(16);
+      if (m_num_hot_rows < 0) {
+        throw ConfigurationError("Number of hot rows ({}) for AddrMapAnalyzer must not be negative!", m_num_hot_rows);
+      }
+      if (m_num_distance_bins < 1) {
+        throw ConfigurationError("Number of conflict distance bins ({}) for AddrMapAnalyzer must be positive!", m_num_distance_bins);
+      }
+      m_clock_ratio = param<uint>("clock_ratio").default_val(1);
+
+      if (m_config["Translation"]) {
+        m_translation = create_child_ifce<ITranslation>();
+      }
+
+      m_logger = Logging::create_logger("AddrMapAnalyzer");
+
+      register_stat(s_num_accesses).name("num_accesses");
+      register_stat(s_num_reads).name("num_reads");
+      register_stat(s_num_writes).name("num_writes");
+      register_stat(s_channel_accesses).name("channel_accesses");
+      register_stat(s_rank_accesses).name("rank_accesses");
+      register_stat(s_bank_accesses).name("bank_accesses");
+      register_stat(s_channel_imbalance).name("channel_imbalance").desc("Max over mean of channel_accesses").computed_at_finalize();
+      register_stat(s_rank_imbalance).name("rank_imbalance").desc("Max over mean of rank_accesses").computed_at_finalize();
+      register_stat(s_bank_imbalance).name("bank_imbalance").desc("Max over mean of bank_accesses").computed_at_finalize();
+      register_stat(s_row_hits).name("row_hits");
+      register_stat(s_row_misses).name("row_misses").desc("First access to a bank");
+      register_stat(s_row_conflicts).name("row_conflicts");
+      register_stat(s_row_hit_rate).name("row_hit_rate").desc("Row hit rate of an ideal open-page policy").computed_at_finalize();
+      register_stat(s_bank_row_hit_rate).name("bank_row_hit_rate").computed_at_finalize();
+      register_stat(s_conflict_distance).name("conflict_distance").desc("Log2 bins of the number of accesses since the previous access to the bank, for row conflicts");
+      register_stat(s_hot_rows).name("hot_rows").desc("flat bank id, row: number of accesses").computed_at_finalize();
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_addr_mapper = memory_system->get_ifce<IAddrMapper>();
+      m_dram = memory_system->get_ifce<IDRAM>();
+
+      m_channel_level = m_dram->m_levels("channel");
+      m_row_level = m_dram->m_levels("row");
+      if (m_dram->m_levels.contains("rank")) {
+        m_rank_level = m_dram->m_levels("rank");
+      } else if (m_dram->m_levels.contains("pseudochannel")) {
+        m_rank_level = m_dram->m_levels("pseudochannel");
+        m_logger->info("The DRAM has no rank level, rank_accesses are per pseudochannel.");
+      } else {
+        m_logger->info("The DRAM has no rank level, rank_accesses are not recorded.");
+      }
+
+      m_num_ranks = 0;
+      if (m_rank_level != -1) {
+        m_num_ranks = m_dram->get_level_size("channel") * m_dram->m_organization.count[m_rank_level];
+      }
+      m_num_banks = 1;
+      for (int level = 0; level < m_row_level; level++) {
+        m_num_banks *= m_dram->m_organization.count[level];
+      }
+
+      m_bank_states.resize(m_num_banks);
+      s_channel_accesses.resize(m_dram->get_level_size("channel"), 0);
+      s_rank_accesses.resize(m_num_ranks, 0);
+      s_bank_accesses.resize(m_num_banks, 0);
+      s_bank_row_hits.resize(m_num_banks, 0);
+      s_bank_row_hit_rate.resize(m_num_banks, 0.0);
+      s_conflict_distance.resize(m_num_distance_bins, 0);
+    };
+
+    void tick() override {
+      // The address mapper is only guaranteed to be set up once the simulation starts
+      if (!m_is_finished) {
+        analyze_trace();
+        m_is_finished = true;
+      }
+    };
+
+    bool is_finished() override {
+      return m_is_finished;
+    };
+
+    void finalize() override {
+      s_channel_imbalance = calc_imbalance(s_channel_accesses);
+      s_rank_imbalance = calc_imbalance(s_rank_accesses);
+      s_bank_imbalance = calc_imbalance(s_bank_accesses);
+
+      if (s_num_accesses > 0) {
+        s_row_hit_rate = (double) s_row_hits / s_num_accesses;
+      }
+      for (int bank = 0; bank < m_num_banks; bank++) {
+        if (s_bank_accesses[bank] > 0) {
+          s_bank_row_hit_rate[bank] = (double) s_bank_row_hits[bank] / s_bank_accesses[bank];
+        }
+      }
+
+      std::vector<std::pair<uint64_t, size_t>> rows(m_row_accesses.begin(), m_row_accesses.end());
+      size_t num_hot_rows = std::min(rows.size(), (size_t) m_num_hot_rows);
+      std::partial_sort(rows.begin(), rows.begin() + num_hot_rows, rows.end(),
+        [](const auto& a, const auto& b) { return a.second > b.second || (a.second == b.second && a.first < b.first); }
+      );
+      for (size_t i = 0; i < num_hot_rows; i++) {
+        s_hot_rows.push_back(fmt::format("{}, {}: {}", rows[i].first >> 32, rows[i].first & 0xFFFFFFFF, rows[i].second));
+      }
+
+      IFrontEnd::finalize();
+    };
+
+  private:
+    void analyze_trace() {
+      fs::path trace_path(m_trace_path);
+      if (!fs::exists(trace_path)) {
+        throw ConfigurationError("Trace {} does not exist!", m_trace_path);
+      }
+
+      std::ifstream trace_file(trace_path);
+      if (!trace_file.is_open()) {
+        throw ConfigurationError("Trace {} cannot be opened!", m_trace_path);
+      }
+
+      m_logger->info("Analyzing trace file {} ...", m_trace_path);
+      std::string line;
+      std::vector<std::string> tokens;
+      while (std::getline(trace_file, line)) {
+        tokens.clear();
+        tokenize(tokens, line, " ");
+
+        if (m_trace_format == "LoadStore") {
+          if (tokens.size() != 2 || (tokens[0] != "LD" && tokens[0] != "ST")) {
+            throw ConfigurationError("Trace {} format invalid!", m_trace_path);
+          }
+          analyze_access(parse_addr(tokens[1]), tokens[0] == "ST" ? Request::Type::Write : Request::Type::Read);
+        } else {
+          if (tokens.size() != 2 && tokens.size() != 3) {
+            throw ConfigurationError("Trace {} format invalid!", m_trace_path);
+          }
+          analyze_access(parse_addr(tokens[1]), Request::Type::Read);
+          if (tokens.size() == 3) {
+            analyze_access(parse_addr(tokens[2]), Request::Type::Write);
+          }
+        }
+      }
+      m_logger->info("Analyzed {} accesses.", s_num_accesses);
+    };
+
+    Addr_t parse_addr(const std::string& token) {
+      if (token.compare(0, 2, "0x") == 0 || token.compare(0, 2, "0X") == 0) {
+        return std::stoll(token.substr(2), nullptr, 16);
+      } else {
+        return std::stoll(token);
+      }
+    };
+
+    void analyze_access(Addr_t addr, int type_id) {
+      Request req(addr, type_id);
+      req.source_id = 0;
+      if (m_translation && !m_translation->translate(req)) {
+        return;
+      }
+      m_addr_mapper->apply(req);
+
+      int channel = req.addr_vec[m_channel_level];
+      int flat_bank_id = 0;
+      for (int level = 0; level < m_row_level; level++) {
+        flat_bank_id = flat_bank_id * m_dram->m_organization.count[level] + req.addr_vec[level];
+      }
+      int row = req.addr_vec[m_row_level];
+
+      s_channel_accesses[channel]++;
+      if (m_rank_level != -1) {
+        int flat_rank_id = channel * m_dram->m_organization.count[m_rank_level] + req.addr_vec[m_rank_level];
+        s_rank_accesses[flat_rank_id]++;
+      }
+      s_bank_accesses[flat_bank_id]++;
+      m_row_accesses[(uint64_t(flat_bank_id) << 32) | uint32_t(row)]++;
+
+      BankState& bank = m_bank_states[flat_bank_id];
+      if (bank.open_row == row) {
+        s_row_hits++;
+        s_bank_row_hits[flat_bank_id]++;
+      } else if (bank.open_row == -1) {
+        s_row_misses++;
+      } else {
+        s_row_conflicts++;
+        size_t distance = s_num_accesses - bank.last_access;
+        int bin = std::min((int) std::bit_width(distance) - 1, m_num_distance_bins - 1);
+        s_conflict_distance[bin]++;
+      }
+      bank.open_row = row;
+      bank.last_access = s_num_accesses;
+
+      s_num_accesses++;
+      if (type_id == Request::Type::Write) {
+        s_num_writes++;
+      } else {
+        s_num_reads++;
+      }
+    };
+
+    double calc_imbalance(const std::vector<size_t>& accesses) {
+      size_t max_accesses = 0;
+      size_t total_accesses = 0;
+      for (size_t count : accesses) {
+        max_accesses = std::max(max_accesses, count);
+        total_accesses += count;
+      }
+      if (total_accesses == 0) {
+        return 0.0;
+      }
+      return (double) max_accesses * accesses.size() / total_accesses;
+    };
+};
+
+}        // namespace Ramulator
@@ -18,7 +18,7 @@ class SST : public IFrontEnd, public Implementation {
       m_memory_system->tick();
     };
 
-    bool receive_external_requests(int req_type_id, Addr_t addr, int source_id, std::function<void(Request&)> callback) override {
+    bool receive_external_requests(int req_type_id, Addr_t addr, int source_id, RequestCallback callback) override {
       return m_memory_system->send({addr, req_type_id, source_id, callback});
     }
 
@@ -1,5 +1,6 @@
 #include <functional>
 #include <limits>
+#include <algorithm>
 
 #include "base/utils.h"
 #include "frontend/frontend.h"
@@ -40,6 +41,7 @@ void BHO3::init() {
 
   // Simulation parameters
   m_num_expected_insts = param<int>("num_expected_insts").desc("Number of instructions that the frontend should execute.").required();
+  m_num_warmup_insts = param<size_t>("num_warmup_insts").desc("Number of instructions per core executed functionally (only warming up the LLC) before the detailed simulation.").default_val(0);
   m_num_max_cycles = param<uint64_t>("num_max_cycles").desc("Number of cycles the frontend is allowed to execute.").default_val(std::numeric_limits<uint64_t>::max());
 
   // Create address translation module
@@ -92,6 +94,9 @@ void BHO3::init() {
 }
 
 void BHO3::tick() {
+  if (m_clk == 0) {
+    warmup();
+  }
   m_clk++;
 
   if(m_clk % 10000000 == 0) {
@@ -129,9 +134,38 @@ bool BHO3::is_finished() {
 }
 
 void BHO3::connect_memory_system(IMemorySystem* memory_system) {
+  IFrontEnd::connect_memory_system(memory_system);
   m_llc->connect_memory_system(memory_system);
 };
 
+/**
+ * @brief   Executes m_num_warmup_insts instructions per core functionally (round robin by trace line) to warm up
+ *          the LLC. Neither the memory system nor the frontend stats see these instructions (the translation
+ *          allocates the pages they touch as usual).
+ * @details
+ * Called in the first cycle rather than in connect_memory_system(), since the translation may need the memory
+ * system (e.g., the address mapper), which is only set up once it is connected to the frontend.
+ */
+void BHO3::warmup() {
+  if (m_num_warmup_insts == 0) {
+    return;
+  }
+  std::vector<size_t> num_remaining(m_num_cores, m_num_warmup_insts);
+  bool is_warming_up = true;
+  while (is_warming_up) {
+    is_warming_up = false;
+    for (int core_id = 0; core_id < m_num_cores; core_id++) {
+      if (num_remaining[core_id] == 0) {
+        continue;
+      }
+      size_t num_insts = m_cores[core_id]->warmup_step();
+      num_remaining[core_id] -= std::min(num_insts, num_remaining[core_id]);
+      is_warming_up = true;
+    }
+  }
+  m_logger->info("Functional warmup of {} instructions per core finished.", m_num_warmup_insts);
+}
+
 int BHO3::get_num_cores() {
   return m_num_cores;
 };
@@ -21,6 +21,7 @@ class BHO3 final : public IFrontEnd, public Implementation {
     BHO3LLC* m_llc;
 
     size_t m_num_expected_insts = 0;
+    size_t m_num_warmup_insts = 0;
     uint64_t m_num_max_cycles = 0;
 
     bool llc_serialize = false;
@@ -37,6 +38,9 @@ class BHO3 final : public IFrontEnd, public Implementation {
     int get_num_cores() override;
     BHO3LLC* get_llc();
     std::vector<BHO3Core*>& get_cores();
+
+  private:
+    void warmup();
 };
 
 }        // namespace Ramulator
\ No newline at end of file
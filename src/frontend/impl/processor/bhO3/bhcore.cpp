@@ -205,6 +205,32 @@ void BHO3Core::tick() {
   m_writeback_addr = inst.store_addr;      
 }
 
+size_t BHO3Core::warmup_step() {
+  size_t num_insts = m_num_bubbles;
+
+  // The lines of attackers are flushed as soon as they are filled
+  if (m_load_addr != -1) {
+    Request load_request(m_load_addr, Request::Type::Read, m_id, m_callback);
+    if (!m_is_attacker && (!m_translation || m_translation->translate(load_request))) {
+      m_llc->warmup_access(load_request.addr, false);
+    }
+    num_insts++;
+  }
+
+  if (m_writeback_addr != -1) {
+    Request writeback_request(m_writeback_addr, Request::Type::Write, m_id, m_callback);
+    if (!m_is_attacker && (!m_translation || m_translation->translate(writeback_request))) {
+      m_llc->warmup_access(writeback_request.addr, true);
+    }
+  }
+
+  auto inst = m_trace.get_next_inst();
+  m_num_bubbles = inst.bubble_count;
+  m_load_addr = inst.load_addr;
+  m_writeback_addr = inst.store_addr;
+  return num_insts;
+}
+
 void BHO3Core::receive(Request& req) {
   Clk_t depart = m_window.set_ready(req.addr);
   Clk_t arrive = m_clk;
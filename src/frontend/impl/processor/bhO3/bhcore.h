@@ -90,7 +90,7 @@ class BHO3Core: public Clocked<BHO3Core> {
     ITranslation* m_translation;
     BHO3LLC* m_llc;
 
-    std::function<void(Request&)> m_callback;
+    RequestCallback m_callback;
 
     int    m_num_bubbles = 0;
     Addr_t m_load_addr = -1;
@@ -129,6 +129,13 @@ class BHO3Core: public Clocked<BHO3Core> {
      */
     void tick() override;
 
+    /**
+     * @brief   Functionally executes the current trace line (warming up the LLC) and fetches the next one.
+     * 
+     * @return  The number of instructions executed.
+     */
+    size_t warmup_step();
+
     /**
      * @brief   Called when a request is served by the memory.
      * 
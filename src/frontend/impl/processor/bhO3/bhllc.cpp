@@ -191,6 +191,24 @@ void BHO3LLC::receive(Request& req) {
   }
 }
 
+void BHO3LLC::warmup_access(Addr_t addr, bool is_write) {
+  CacheSet_t& set = get_set(addr);
+  Addr_t tag = get_tag(addr);
+  auto line_it = std::find_if(set.begin(), set.end(), [tag](const Line& l) { return l.tag == tag; });
+  if (line_it != set.end()) {
+    // Hit, move the line to the most-recently-used position
+    set.push_back({line_it->addr, tag, line_it->dirty || is_write, true});
+    set.erase(line_it);
+    return;
+  }
+
+  // Miss, evict the least-recently-used line (its writeback does not reach the DRAM) and allocate
+  if (set.size() >= m_associativity) {
+    set.pop_front();
+  }
+  set.push_back({addr, tag, is_write, true});
+}
+
 BHO3LLC::CacheSet_t& BHO3LLC::get_set(Addr_t addr) {
   int set_index = get_index(addr);
   if (m_cache_sets.find(set_index) == m_cache_sets.end()) {
@@ -103,6 +103,12 @@ class BHO3LLC : public Clocked<BHO3LLC> {
     bool send(Request& req);
     void receive(Request& req);
 
+    /**
+     * @brief   Functionally accesses the LLC (warmup): updates the contents and LRU state without timing or stats.
+     * 
+     */
+    void warmup_access(Addr_t addr, bool is_write);
+
     void serialize(std::string serialization_filename);
     void deserialize(std::string serialization_filename);
     void dump_llc();
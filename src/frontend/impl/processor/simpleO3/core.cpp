@@ -112,11 +112,17 @@ m_id(id), m_window(ipc, depth), m_trace(trace_path), m_num_expected_insts(num_ex
 }
 
 void SimpleO3Core::tick() {
+  tick_window();
+  tick_llc_access();
+}
+
+void SimpleO3Core::tick_window() {
   m_clk++;
+  m_is_accessing_llc = false;
 
   s_insts_retired += m_window.retire();
   if (!reached_expected_num_insts) {
-    if (s_insts_retired >= m_num_expected_insts) {
+    if (s_insts_retired + m_num_fast_forwarded_insts >= m_num_expected_insts) {
       reached_expected_num_insts = true;
       s_cycles_recorded = m_clk;
     }
@@ -136,7 +142,7 @@ void SimpleO3Core::tick() {
     m_num_bubbles--;
   }
 
-  // Second, try to send the load to the LLC
+  // The load needs a free slot in the window
   if (m_load_addr != -1) {
     if (num_inserted_insts == m_window.m_ipc) {
       return;
@@ -144,7 +150,17 @@ void SimpleO3Core::tick() {
     if (m_window.is_full()) {
       return;
     };
+  }
+  m_is_accessing_llc = true;
+}
+
+void SimpleO3Core::tick_llc_access() {
+  if (!m_is_accessing_llc) {
+    return;
+  }
 
+  // Second, try to send the load to the LLC
+  if (m_load_addr != -1) {
     Request load_request(m_load_addr, Request::Type::Read, m_id, m_callback);
     if (!m_translation->translate(load_request)) {
       return;
@@ -181,6 +197,31 @@ void SimpleO3Core::tick() {
   m_writeback_addr = inst.store_addr;      
 }
 
+size_t SimpleO3Core::warmup_step() {
+  size_t num_insts = m_num_bubbles;
+
+  if (m_load_addr != -1) {
+    Request load_request(m_load_addr, Request::Type::Read, m_id, m_callback);
+    if (m_translation->translate(load_request)) {
+      m_llc->warmup_access(load_request.addr, false);
+    }
+    num_insts++;
+  }
+
+  if (m_writeback_addr != -1) {
+    Request writeback_request(m_writeback_addr, Request::Type::Write, m_id, m_callback);
+    if (m_translation->translate(writeback_request)) {
+      m_llc->warmup_access(writeback_request.addr, true);
+    }
+  }
+
+  auto inst = m_trace.get_next_inst();
+  m_num_bubbles = inst.bubble_count;
+  m_load_addr = inst.load_addr;
+  m_writeback_addr = inst.store_addr;
+  return num_insts;
+}
+
 void SimpleO3Core::receive(Request& req) {
   m_window.set_ready(req.addr);
 
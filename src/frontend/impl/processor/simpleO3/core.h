@@ -86,15 +86,18 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
     ITranslation* m_translation;
     SimpleO3LLC* m_llc;
 
-    std::function<void(Request&)> m_callback;
+    RequestCallback m_callback;
 
     int    m_num_bubbles = 0;
     Addr_t m_load_addr = -1;
     Addr_t m_writeback_addr = -1;
 
     size_t m_num_expected_insts = 0;  
+    size_t m_num_fast_forwarded_insts = 0;  // Instructions skipped by sampled simulation, counted towards m_num_expected_insts
     Clk_t m_last_mem_cycle = 0; // The last cycle that a memory request departs from mc
 
+    bool m_is_accessing_llc = false;  // Whether the core reached its load/writeback in this cycle (set by tick_window())
+
   /************************************************
    *              Core Statistics
    ***********************************************/
@@ -113,6 +116,28 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
      */
     void tick() override;
 
+    /**
+     * @brief   First stage of tick(): retires instructions and inserts the non-memory instructions.
+     * @details
+     * Only touches the core itself, so different cores can run this stage concurrently.
+     * 
+     */
+    void tick_window();
+
+    /**
+     * @brief   Second stage of tick(): sends the load/writeback reached by tick_window() to the LLC and fetches the
+     * next trace line.
+     * 
+     */
+    void tick_llc_access();
+
+    /**
+     * @brief   Functionally executes the current trace line (warming up the LLC) and fetches the next one.
+     * 
+     * @return  The number of instructions executed.
+     */
+    size_t warmup_step();
+
     /**
      * @brief   Called when a request is served by the memory.
      * 
@@ -29,6 +29,7 @@ void SimpleO3LLC::tick() {
         it++;
       }
       else {
+        m_num_memory_requests++;
         it = m_miss_list.erase(it);
       }
     } else {
@@ -164,6 +165,33 @@ void SimpleO3LLC::receive(Request& req) {
   }
 };
 
+void SimpleO3LLC::warmup_access(Addr_t addr, bool is_write) {
+  CacheSet_t& set = get_set(addr);
+  Addr_t tag = get_tag(addr);
+  auto line_it = std::find_if(set.begin(), set.end(), [tag](const Line& l) { return l.tag == tag; });
+  if (line_it != set.end()) {
+    if (!line_it->ready) {
+      // The line is still inflight (tracked by an MSHR), leave it to the miss
+      return;
+    }
+    // Hit, move the line to the most-recently-used position (splice keeps the iterators of the set valid)
+    line_it->dirty = line_it->dirty || is_write;
+    set.splice(set.end(), set, line_it);
+    return;
+  }
+
+  // Miss, evict the least-recently-used ready line (its writeback does not reach the DRAM) and allocate
+  if (set.size() >= m_associativity) {
+    auto victim = std::find_if(set.begin(), set.end(), [](const Line& l) { return l.ready; });
+    if (victim == set.end()) {
+      // Every line is inflight, do not allocate
+      return;
+    }
+    set.erase(victim);
+  }
+  set.push_back({addr, tag, is_write, true});
+}
+
 SimpleO3LLC::CacheSet_t& SimpleO3LLC::get_set(Addr_t addr) {
   int set_index = get_index(addr);
   if (m_cache_sets.find(set_index) == m_cache_sets.end()) {
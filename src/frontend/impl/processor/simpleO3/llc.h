@@ -69,6 +69,8 @@ class SimpleO3LLC : public Clocked<SimpleO3LLC> {
     int s_llc_write_misses = 0;
     int s_llc_eviction = 0;
     int s_llc_mshr_unavailable = 0;
+
+    size_t m_num_memory_requests = 0;   // Requests sent to the memory system (misses and writebacks)
     
 
   public:
@@ -79,6 +81,15 @@ class SimpleO3LLC : public Clocked<SimpleO3LLC> {
     bool send(Request req);
     void receive(Request& req);
 
+    /**
+     * @brief   Functionally accesses the LLC (warmup): updates the contents and LRU state without timing or stats.
+     * @details
+     * Can be called while misses are outstanding (sampled simulation): lines that are still inflight are never
+     * touched or evicted.
+     * 
+     */
+    void warmup_access(Addr_t addr, bool is_write);
+
     void serialize(std::string serialization_filename);
     void deserialize(std::string serialization_filename);
     void dump_llc();
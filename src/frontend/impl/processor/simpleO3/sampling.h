@@ -0,0 +1,69 @@
+#ifndef     RAMULATOR_FRONTEND_PROCESSOR_SIMPLEO3_SAMPLING_H
+#define     RAMULATOR_FRONTEND_PROCESSOR_SIMPLEO3_SAMPLING_H
+
+#include <cmath>
+#include <cstddef>
+
+namespace Ramulator {
+
+/**
+ * @brief   A metric measured once per sampling window, e.g., the IPC.
+ * @details
+ * Keeps the running mean and variance of the window values (Welford's algorithm), from which the confidence
+ * interval of the mean follows by the central limit theorem.
+ */
+class WindowMetric {
+  private:
+    size_t m_count = 0;
+    double m_mean = 0.0;
+    double m_m2 = 0.0;      // Sum of the squared differences from the mean
+
+  public:
+    void add(double value) {
+      m_count++;
+      double delta = value - m_mean;
+      m_mean += delta / m_count;
+      m_m2 += delta * (value - m_mean);
+    };
+
+    size_t get_count() const { return m_count; };
+    double get_mean() const { return m_mean; };
+    double get_stddev() const { return m_count > 1 ? std::sqrt(m_m2 / (m_count - 1)) : 0.0; };
+
+    /**
+     * @brief   Half width of the confidence interval of the mean, for the standard normal quantile z.
+     */
+    double get_ci_half_width(double z) const {
+      return m_count > 1 ? z * get_stddev() / std::sqrt((double) m_count) : 0.0;
+    };
+
+    /**
+     * @brief   The half width of the confidence interval relative to the mean.
+     */
+    double get_relative_error(double z) const {
+      return m_mean != 0.0 ? get_ci_half_width(z) / std::abs(m_mean) : 0.0;
+    };
+
+    /**
+     * @brief   Returns z such that a standard normal variable is within [-z, z] with probability confidence.
+     */
+    static double get_z(double confidence) {
+      // Bisection on the normal CDF, 0.5 * (1 + erf(x / sqrt(2)))
+      double target = (1.0 + confidence) / 2.0;
+      double low = 0.0, high = 10.0;
+      for (int i = 0; i < 64; i++) {
+        double mid = (low + high) / 2.0;
+        if (0.5 * (1.0 + std::erf(mid / std::sqrt(2.0))) < target) {
+          low = mid;
+        } else {
+          high = mid;
+        }
+      }
+      return (low + high) / 2.0;
+    };
+};
+
+}        // namespace Ramulator
+
+
+#endif   // RAMULATOR_FRONTEND_PROCESSOR_SIMPLEO3_SAMPLING_H
@@ -1,10 +1,15 @@
+#include <algorithm>
+#include <barrier>
 #include <functional>
+#include <memory>
+#include <thread>
 
 #include "base/utils.h"
 #include "frontend/frontend.h"
 #include "translation/translation.h"
 #include "frontend/impl/processor/simpleO3/core.h"
 #include "frontend/impl/processor/simpleO3/llc.h"
+#include "frontend/impl/processor/simpleO3/sampling.h"
 
 
 namespace Ramulator {
@@ -20,6 +25,44 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
     SimpleO3LLC* m_llc;
 
     size_t m_num_expected_insts = 0;
+    size_t m_num_warmup_insts = 0;
+
+    // Parallel core ticking: every cycle, each thread runs tick_window() on its own block of cores, then the calling
+    // thread runs tick_llc_access() on all cores in core order, so the LLC sees the same sequence as in a serial run
+    int m_num_threads = 1;
+    std::vector<std::thread> m_workers;                 // Threads 1, ..., m_num_threads - 1 (thread 0 is the caller)
+    std::unique_ptr<std::barrier<>> m_cycle_barrier;    // Starts and ends the window stage of a cycle
+    bool m_is_stopping_workers = false;
+
+    // Sampled simulation: every interval is fast-forwarded functionally except for a detailed warmup followed by
+    // a measured window at its end
+    enum class SamplingPhase { Off, DetailedWarmup, Measure, Converged };
+    SamplingPhase m_sampling_phase = SamplingPhase::Off;
+    size_t m_sampling_interval_insts = 0;
+    size_t m_sampling_warmup_insts = 0;
+    size_t m_sampling_window_insts = 0;
+    size_t m_sampling_min_windows = 30;
+    double m_sampling_target_error = 0.0;
+    double m_sampling_z = 0.0;
+
+    std::vector<size_t> m_phase_start_insts;   // Instructions retired by each core when the current phase started
+    Clk_t  m_window_start_clk = 0;
+    size_t m_window_start_memory_requests = 0;
+    uint64_t m_window_read_latency_sum = 0;
+    size_t m_window_num_reads = 0;
+
+    WindowMetric m_sampled_ipc;
+    WindowMetric m_sampled_bandwidth;
+    WindowMetric m_sampled_read_latency;
+
+    size_t s_num_sampled_windows = 0;
+    double s_sampled_ipc_mean = 0.0;
+    double s_sampled_ipc_ci = 0.0;
+    double s_sampled_ipc_rel_error = 0.0;
+    double s_sampled_bandwidth_mean = 0.0;
+    double s_sampled_bandwidth_ci = 0.0;
+    double s_sampled_read_latency_mean = 0.0;
+    double s_sampled_read_latency_ci = 0.0;
 
     std::string serialization_filename;
 
@@ -44,6 +87,32 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
 
       // Simulation parameters
       m_num_expected_insts = param<int>("num_expected_insts").desc("Number of instructions that the frontend should execute.").required();
+      m_num_threads = param<int>("num_threads").desc("Number of host threads that tick the cores (1 ticks them serially). The results do not depend on it.").default_val(1);
+      if (m_num_threads < 1) {
+        throw ConfigurationError("SimpleO3: num_threads ({}) must be at least 1!", m_num_threads);
+      }
+      m_num_threads = std::min(m_num_threads, m_num_cores);
+      m_num_warmup_insts = param<size_t>("num_warmup_insts").desc("Number of instructions per core executed functionally (only warming up the LLC) before the detailed simulation.").default_val(0);
+
+      m_sampling_interval_insts = param<size_t>("sampling_interval_insts").desc("Number of instructions per core between the starts of two measured windows in sampled simulation (0 disables sampling).").default_val(0);
+      m_sampling_warmup_insts = param<size_t>("sampling_detailed_warmup_insts").desc("Number of instructions per core simulated in detail, but not measured, before each measured window.").default_val(0);
+      m_sampling_window_insts = param<size_t>("sampling_window_insts").desc("Number of instructions per core in each measured window.").default_val(10000);
+      m_sampling_target_error = param<double>("sampling_target_error").desc("Stop once the confidence interval of the IPC is within this fraction of its mean (0 runs to num_expected_insts).").default_val(0.0);
+      double sampling_confidence = param<double>("sampling_confidence").desc("Confidence level of the reported confidence intervals.").default_val(0.95);
+      m_sampling_min_windows = param<size_t>("sampling_min_windows").desc("Minimum number of measured windows before the simulation can stop at the target error.").default_val(30);
+      if (m_sampling_interval_insts > 0) {
+        if (m_sampling_window_insts == 0) {
+          throw ConfigurationError("SimpleO3: sampling_window_insts must be positive!");
+        }
+        if (m_sampling_interval_insts < m_sampling_warmup_insts + m_sampling_window_insts) {
+          throw ConfigurationError("SimpleO3: sampling_interval_insts ({}) must be at least sampling_detailed_warmup_insts + sampling_window_insts ({})!",
+                                   m_sampling_interval_insts, m_sampling_warmup_insts + m_sampling_window_insts);
+        }
+        if (sampling_confidence <= 0.0 || sampling_confidence >= 1.0) {
+          throw ConfigurationError("SimpleO3: sampling_confidence must be in (0, 1)!");
+        }
+        m_sampling_z = WindowMetric::get_z(sampling_confidence);
+      }
 
       // Create address translation module
       m_translation = create_child_ifce<ITranslation>();
@@ -59,6 +128,7 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
         core->m_callback = [this](Request& req){return this->receive(req);} ;
         m_cores.push_back(core);
       }
+      start_workers();
 
       m_logger = Logging::create_logger("SimpleO3");
 
@@ -76,9 +146,26 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
         register_stat(m_cores[core_id]->s_cycles_recorded).name("cycles_recorded_core_{}", core_id);
         register_stat(m_cores[core_id]->s_mem_access_cycles).name("memory_access_cycles_recorded_core_{}", core_id);
       }
+
+      if (m_sampling_interval_insts > 0) {
+        register_stat(s_num_sampled_windows).name("sampling_num_windows");
+        register_stat(s_sampled_ipc_mean).name("sampling_ipc_mean").desc("Mean IPC (all cores) of the measured windows");
+        register_stat(s_sampled_ipc_ci).name("sampling_ipc_ci").desc("Half width of the confidence interval of the IPC");
+        register_stat(s_sampled_ipc_rel_error).name("sampling_ipc_rel_error").desc("sampling_ipc_ci relative to sampling_ipc_mean");
+        register_stat(s_sampled_bandwidth_mean).name("sampling_bandwidth_mean").desc("Mean memory bandwidth (bytes per processor cycle) of the measured windows");
+        register_stat(s_sampled_bandwidth_ci).name("sampling_bandwidth_ci").desc("Half width of the confidence interval of the memory bandwidth");
+        register_stat(s_sampled_read_latency_mean).name("sampling_read_latency_mean").desc("Mean memory read latency (memory cycles) of the measured windows");
+        register_stat(s_sampled_read_latency_ci).name("sampling_read_latency_ci").desc("Half width of the confidence interval of the memory read latency");
+      }
     }
 
     void tick() override {
+      if (m_clk == 0) {
+        warmup();
+        if (m_sampling_interval_insts > 0) {
+          start_sampling_interval();
+        }
+      }
       m_clk++;
 
       if(m_clk % 10000000 == 0) {
@@ -86,14 +173,24 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
       }
 
       m_llc->tick();
+      tick_windows();
       for (auto core : m_cores) {
-        core->tick();
+        core->tick_llc_access();
+      }
+
+      if (m_sampling_phase == SamplingPhase::DetailedWarmup || m_sampling_phase == SamplingPhase::Measure) {
+        update_sampling();
       }
     }
 
     void receive(Request& req) {
       m_llc->receive(req);
 
+      if (m_sampling_phase == SamplingPhase::Measure && req.type_id == Request::Type::Read && req.arrive != -1) {
+        m_window_read_latency_sum += req.depart - req.arrive;
+        m_window_num_reads++;
+      }
+
       // TODO: LLC latency for the core to receive the request?
       for (auto r : m_llc->m_receive_requests[req.addr]) {
         r.arrive = req.arrive;
@@ -103,7 +200,19 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
       m_llc->m_receive_requests[req.addr].clear();
     };
 
+    void finalize() override {
+      stop_workers();
+      IFrontEnd::finalize();
+    };
+
+    ~SimpleO3() {
+      stop_workers();
+    };
+
     bool is_finished() override {
+      if (m_sampling_phase == SamplingPhase::Converged) {
+        return true;
+      }
       for (auto core : m_cores) {
         if (!(core->reached_expected_num_insts)){
           return false;
@@ -113,12 +222,182 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
     }
 
     void connect_memory_system(IMemorySystem* memory_system) override {
+      IFrontEnd::connect_memory_system(memory_system);
       m_llc->connect_memory_system(memory_system);
     };
 
     int get_num_cores() override {
       return m_num_cores;
     };
+
+  private:
+    void start_workers() {
+      if (m_num_threads == 1) {
+        return;
+      }
+      m_cycle_barrier = std::make_unique<std::barrier<>>(m_num_threads);
+      for (int thread_id = 1; thread_id < m_num_threads; thread_id++) {
+        m_workers.emplace_back([this, thread_id]() {
+          while (true) {
+            m_cycle_barrier->arrive_and_wait();
+            if (m_is_stopping_workers) {
+              return;
+            }
+            tick_windows(thread_id);
+            m_cycle_barrier->arrive_and_wait();
+          }
+        });
+      }
+    };
+
+    void stop_workers() {
+      if (m_workers.empty()) {
+        return;
+      }
+      m_is_stopping_workers = true;
+      m_cycle_barrier->arrive_and_wait();
+      for (auto& worker : m_workers) {
+        worker.join();
+      }
+      m_workers.clear();
+    };
+
+    /**
+     * @brief   Runs the window stage of every core, on m_num_threads threads.
+     */
+    void tick_windows() {
+      if (m_workers.empty()) {
+        tick_windows(0);
+        return;
+      }
+      m_cycle_barrier->arrive_and_wait();
+      tick_windows(0);
+      m_cycle_barrier->arrive_and_wait();
+    };
+
+    /**
+     * @brief   Runs the window stage of the block of cores of a thread.
+     */
+    void tick_windows(int thread_id) {
+      int first_core_id = thread_id * m_num_cores / m_num_threads;
+      int last_core_id = (thread_id + 1) * m_num_cores / m_num_threads;
+      for (int core_id = first_core_id; core_id < last_core_id; core_id++) {
+        m_cores[core_id]->tick_window();
+      }
+    };
+
+    /**
+     * @brief   Fast-forwards every core by m_num_warmup_insts instructions (called in the first cycle).
+     * @details
+     * Not done in connect_memory_system(): the translation may need the memory system (e.g., the address mapper
+     * for page coloring), which is only set up once the memory system is connected to the frontend.
+     */
+    void warmup() {
+      if (m_num_warmup_insts == 0) {
+        return;
+      }
+      fast_forward(m_num_warmup_insts, false);
+      m_logger->info("Functional warmup of {} instructions per core finished.", m_num_warmup_insts);
+    };
+
+    /**
+     * @brief   Fast-forwards every core by num_insts instructions without simulating timing.
+     * @details
+     * The cores take turns by trace line, so that they share the LLC as in the detailed simulation. Nothing is
+     * sent to the memory system and no frontend stats are recorded, so the detailed simulation starts from warm
+     * caches with the frontend stats at zero. The pages touched are allocated by the translation as usual (and
+     * counted in its stats). If is_counted, the instructions count towards num_expected_insts (sampled
+     * simulation) rather than being skipped (warmup).
+     */
+    void fast_forward(size_t num_insts, bool is_counted) {
+      if (num_insts == 0) {
+        return;
+      }
+      std::vector<size_t> num_remaining(m_num_cores, num_insts);
+      bool is_fast_forwarding = true;
+      while (is_fast_forwarding) {
+        is_fast_forwarding = false;
+        for (int core_id = 0; core_id < m_num_cores; core_id++) {
+          if (num_remaining[core_id] == 0) {
+            continue;
+          }
+          size_t num_executed = m_cores[core_id]->warmup_step();
+          num_remaining[core_id] -= std::min(num_executed, num_remaining[core_id]);
+          if (is_counted) {
+            m_cores[core_id]->m_num_fast_forwarded_insts += num_executed;
+          }
+          is_fast_forwarding = true;
+        }
+      }
+    };
+
+    /**
+     * @brief   Fast-forwards to the detailed warmup at the end of the next sampling interval.
+     */
+    void start_sampling_interval() {
+      fast_forward(m_sampling_interval_insts - m_sampling_warmup_insts - m_sampling_window_insts, true);
+      start_sampling_phase(SamplingPhase::DetailedWarmup);
+    };
+
+    void start_sampling_phase(SamplingPhase phase) {
+      m_sampling_phase = phase;
+      m_phase_start_insts.resize(m_num_cores);
+      for (int core_id = 0; core_id < m_num_cores; core_id++) {
+        m_phase_start_insts[core_id] = m_cores[core_id]->s_insts_retired;
+      }
+      if (phase == SamplingPhase::Measure) {
+        m_window_start_clk = m_clk;
+        m_window_start_memory_requests = m_llc->m_num_memory_requests;
+        m_window_read_latency_sum = 0;
+        m_window_num_reads = 0;
+      }
+    };
+
+    /**
+     * @brief   Advances the sampling phase once every core has retired the instructions of the current phase.
+     */
+    void update_sampling() {
+      size_t num_phase_insts = m_sampling_phase == SamplingPhase::DetailedWarmup ? m_sampling_warmup_insts : m_sampling_window_insts;
+      size_t num_retired_insts = 0;
+      for (int core_id = 0; core_id < m_num_cores; core_id++) {
+        size_t num_core_insts = m_cores[core_id]->s_insts_retired - m_phase_start_insts[core_id];
+        if (num_core_insts < num_phase_insts) {
+          return;
+        }
+        num_retired_insts += num_core_insts;
+      }
+
+      if (m_sampling_phase == SamplingPhase::DetailedWarmup) {
+        start_sampling_phase(SamplingPhase::Measure);
+        return;
+      }
+
+      // The measured window is over
+      double num_cycles = std::max<Clk_t>(m_clk - m_window_start_clk, 1);
+      size_t num_memory_requests = m_llc->m_num_memory_requests - m_window_start_memory_requests;
+      m_sampled_ipc.add(num_retired_insts / num_cycles);
+      m_sampled_bandwidth.add(num_memory_requests * m_llc->m_linesize_bytes / num_cycles);
+      if (m_window_num_reads > 0) {
+        m_sampled_read_latency.add((double) m_window_read_latency_sum / m_window_num_reads);
+      }
+
+      s_num_sampled_windows = m_sampled_ipc.get_count();
+      s_sampled_ipc_mean = m_sampled_ipc.get_mean();
+      s_sampled_ipc_ci = m_sampled_ipc.get_ci_half_width(m_sampling_z);
+      s_sampled_ipc_rel_error = m_sampled_ipc.get_relative_error(m_sampling_z);
+      s_sampled_bandwidth_mean = m_sampled_bandwidth.get_mean();
+      s_sampled_bandwidth_ci = m_sampled_bandwidth.get_ci_half_width(m_sampling_z);
+      s_sampled_read_latency_mean = m_sampled_read_latency.get_mean();
+      s_sampled_read_latency_ci = m_sampled_read_latency.get_ci_half_width(m_sampling_z);
+
+      if (m_sampling_target_error > 0.0 && s_num_sampled_windows >= m_sampling_min_windows && s_sampled_ipc_rel_error <= m_sampling_target_error) {
+        m_sampling_phase = SamplingPhase::Converged;
+        m_logger->info("Sampled simulation converged after {} windows: IPC {:.4f} +- {:.4f} ({:.2f}%).",
+                       s_num_sampled_windows, s_sampled_ipc_mean, s_sampled_ipc_ci, s_sampled_ipc_rel_error * 100.0);
+        return;
+      }
+      start_sampling_interval();
+    };
 };
 
 }        // namespace Ramulator
\ No newline at end of file
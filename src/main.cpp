@@ -17,9 +17,16 @@ int main(int argc, char* argv[]) {
     .help("String dump of the yaml configuration.");
   program.add_argument("-f", "--config_file").metavar("path-to-configuration-file")
     .help("Path to a YAML configuration file.");
+  program.add_argument("--dump_resolved_config").metavar("path-to-output-file")
+    .help("Write the configuration with its includes resolved and parameter overrides applied to this file, and exit.");
   program.add_argument("-p", "--param").metavar("KEY=VALUE")
     .append()
     .help("Specify parameter to override in the configuration file. Repeat this option to change multiple parameters.");
+  program.add_argument("--stats_file").metavar("path-to-stats-file")
+    .help("Write the statistics to this file instead of printing them as YAML.");
+  program.add_argument("--stats_format").metavar("json|binary")
+    .default_value(std::string("json"))
+    .help("Format of the statistics file.");
 
   try {
     program.parse_args(argc, argv);
@@ -68,7 +75,7 @@ int main(int argc, char* argv[]) {
   if (use_dumped_yaml && has_param_override) {
     spdlog::warn("Using dumped configuration. Parameter overrides with -p/--param will be ignored!");
   }
-  
+
   // Parse the configurations
   YAML::Node config;
   if (use_dumped_yaml) {
@@ -78,6 +85,23 @@ int main(int argc, char* argv[]) {
     config = Ramulator::Config::parse_config_file(config_file_path, params);
   }
 
+  // Are we only resolving the configuration?
+  if (auto arg = program.present<std::string>("--dump_resolved_config")) {
+    Ramulator::Config::dump_resolved_config(config, *arg);
+    return 0;
+  }
+
+  // Are we writing the statistics to a file?
+  if (auto arg = program.present<std::string>("--stats_file")) {
+    try {
+      Ramulator::StatsSink::open(*arg, program.get<std::string>("--stats_format"));
+    }
+    catch (const std::runtime_error& err) {
+      spdlog::error(err.what());
+      std::exit(1);
+    }
+  }
+
   // Instaniate the frontend of the simulated system, this is one of the top-level objects in Ramulator 2.0.
   // It also recursively instaniate all components in the frontend.
   auto frontend = Ramulator::Factory::create_frontend(config);
@@ -114,6 +138,7 @@ int main(int argc, char* argv[]) {
   // Finalize the simulation. Recursively print all statistics from all components
   frontend->finalize();
   memory_system->finalize();
+  Ramulator::StatsSink::close_sink();
 
   return 0;
 }
\ No newline at end of file
@@ -19,6 +19,7 @@ class BHDRAMSystem final : public IBHMemorySystem, public Implementation {
     int s_num_read_requests = 0;
     int s_num_write_requests = 0;
     int s_num_other_requests = 0;
+    uint64_t s_rng_seed = 0;
 
 
   public:
@@ -43,6 +44,9 @@ class BHDRAMSystem final : public IBHMemorySystem, public Implementation {
       register_stat(s_num_read_requests).name("total_num_read_requests");
       register_stat(s_num_write_requests).name("total_num_write_requests");
       register_stat(s_num_other_requests).name("total_num_other_requests");
+
+      s_rng_seed = RandomService::get_global_seed();
+      register_stat(s_rng_seed).name("rng_seed").desc("Global seed of all random number streams");
     };
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override { }
@@ -77,6 +81,7 @@ class BHDRAMSystem final : public IBHMemorySystem, public Implementation {
       for (auto controller : m_controllers) {
         controller->tick();
       }
+      m_stat_sampler.tick(m_clk);
     };
 
     float get_tCK() override {
@@ -7,6 +7,7 @@
 #include <functional>
 
 #include "base/base.h"
+#include "base/stat_sampler.h"
 #include "frontend/frontend.h"
 
 namespace Ramulator {
@@ -19,6 +20,7 @@ class IMemorySystem : public TopLevel<IMemorySystem> {
   protected:
     IFrontEnd* m_frontend;
     uint m_clock_ratio = 1;
+    StatSampler m_stat_sampler;   // Samples the stats of the memory system during the simulation
 
   public:
     virtual void connect_frontend(IFrontEnd* frontend) { 
@@ -27,12 +29,19 @@ class IMemorySystem : public TopLevel<IMemorySystem> {
       for (auto component : m_components) {
         component->setup(frontend, this);
       }
+      m_stat_sampler.init(m_impl);
     };
 
     virtual void finalize() { 
       for (auto component : m_components) {
         component->finalize();
       }
+      m_stat_sampler.finalize();
+
+      if (StatsSink* sink = StatsSink::get()) {
+        m_impl->write_stats(*sink);
+        return;
+      }
 
       YAML::Emitter emitter;
       emitter << YAML::BeginMap;
@@ -0,0 +1,310 @@
+#include <vector>
+#include <limits>
+
+#include "base/base.h"
+#include "translation/translation.h"
+#include "frontend/frontend.h"
+#include "memory_system/memory_system.h"
+#include "translation/impl/paging.h"
+
+
+namespace Ramulator {
+
+/**
+ * @brief   Common machinery for translations backed by a buddy allocator.
+ * @details
+ * Physical memory is managed in 4KB frames. Each page size has its own per-core page table, looked up from the
+ * largest to the smallest size. The first touch to a virtual region of a page size decides (with the configured
+ * probability) whether the region is backed by a single page of that size, or split into smaller pages.
+ */
+class BuddyTranslationBase : public ITranslation {
+  protected:
+    static constexpr int m_offsetbits = 12;   // Physical memory is managed at 4KB frame granularity
+    static constexpr int m_max_order = 18;    // The largest buddy block is 1GB
+
+    struct TLBEntry {
+      Addr_t vfn = -1;
+      Addr_t pfn = -1;
+    };
+
+    using PFN_t = uint32_t;
+
+    IFrontEnd* m_frontend = nullptr;
+    Logger_t m_translation_logger;
+
+    RandomStream m_allocator_rng;
+
+    Addr_t m_max_paddr = -1;
+    size_t m_num_frames = 0;
+    BuddyAllocator m_allocator;
+
+    // All frames, partitioned as [usable | reserved], so that a random swap victim is drawn in O(1)
+    std::vector<PFN_t> m_frames;
+    std::vector<PFN_t> m_frame_slots;       // The position of each frame in m_frames
+    size_t m_num_usable_frames = 0;         // Frames in [0, m_num_usable_frames) are not reserved
+
+    std::vector<int> m_page_orders;          // log2 of the number of frames of each page size, largest first
+    std::vector<double> m_page_fractions;    // Probability that a fresh virtual region is backed by a page of this size
+
+    std::vector<std::vector<PageTable>> m_translation;   // Per-core page tables, one for each page size
+    int m_tlb_entries = -1;
+    std::vector<TLBEntry> m_tlb;                         // Per-core TLBs at frame granularity, flattened as [core][entry]
+
+    PageColorMap m_colors;
+    std::vector<std::vector<size_t>> m_block_channel_frames;   // [order][channel], filled on the first block of the order
+
+    std::vector<size_t> s_num_pages;         // Number of pages allocated, per page size
+    size_t s_num_huge_page_fallbacks = 0;
+    size_t s_num_swapped_frames = 0;
+    size_t s_free_frames = 0;
+    size_t s_largest_free_block_frames = 0;
+    double s_external_fragmentation = 0.0;
+    std::vector<size_t> s_channel_frames;    // Number of allocated frames whose base maps to each channel
+    double s_channel_imbalance = 0.0;
+
+  protected:
+    void init_translation(Implementation* impl, const std::vector<int>& page_orders, const std::vector<double>& page_fractions) {
+      m_max_paddr = impl->param<Addr_t>("max_addr").desc("Max physical address of the memory system.").required();
+      m_tlb_entries = impl->param<int>("tlb_entries").desc("Number of entries of the per-core direct-mapped translation cache.").default_val(64);
+      if (m_tlb_entries <= 0 || (m_tlb_entries & (m_tlb_entries - 1)) != 0) {
+        throw ConfigurationError("Number of TLB entries ({}) for {} must be a power of two!", m_tlb_entries, impl->get_name());
+      }
+
+      m_page_orders = page_orders;
+      m_page_fractions = page_fractions;
+
+      m_num_frames = m_max_paddr >> m_offsetbits;
+      if (m_num_frames > std::numeric_limits<PFN_t>::max()) {
+        throw ConfigurationError("Too many physical frames ({}) for {}!", m_num_frames, impl->get_name());
+      }
+      m_allocator = BuddyAllocator(m_num_frames, m_max_order);
+      m_frames.resize(m_num_frames);
+      m_frame_slots.resize(m_num_frames);
+      for (size_t frame = 0; frame < m_num_frames; frame++) {
+        m_frames[frame] = frame;
+        m_frame_slots[frame] = frame;
+      }
+      m_num_usable_frames = m_num_frames;
+      m_block_channel_frames.resize(m_max_order + 1);
+
+      m_frontend = impl->cast_parent<IFrontEnd>();
+      int num_cores = m_frontend->get_num_cores();
+      m_translation.resize(num_cores);
+      for (auto& core_translation : m_translation) {
+        for (int order : m_page_orders) {
+          core_translation.emplace_back(std::numeric_limits<Addr_t>::digits - m_offsetbits - order);
+        }
+      }
+      m_tlb.resize(num_cores * m_tlb_entries);
+
+      m_translation_logger = Logging::create_logger(impl->get_name());
+
+      s_num_pages.resize(m_page_orders.size(), 0);
+      impl->register_stat(s_num_pages).name("num_pages").desc("Number of pages allocated, per page size from the largest");
+      impl->register_stat(s_num_huge_page_fallbacks).name("num_huge_page_fallbacks");
+      impl->register_stat(s_num_swapped_frames).name("num_swapped_frames");
+      impl->register_stat(s_free_frames).name("free_frames").computed_at_finalize();
+      impl->register_stat(s_largest_free_block_frames).name("largest_free_block_frames").computed_at_finalize();
+      impl->register_stat(s_external_fragmentation).name("external_fragmentation").computed_at_finalize();
+      impl->register_stat(s_channel_frames).name("channel_frames");
+      impl->register_stat(s_channel_imbalance).name("channel_imbalance").desc("Max over mean of channel_frames").computed_at_finalize();
+    };
+
+    void setup_translation(Implementation* impl, IMemorySystem* memory_system) {
+      m_allocator_rng = impl->create_rng_stream();
+      m_colors.setup(memory_system->get_ifce<IAddrMapper>(), m_offsetbits, false);
+    };
+
+    void finalize_translation() {
+      s_free_frames = m_allocator.get_num_free_frames();
+      s_largest_free_block_frames = m_allocator.get_largest_free_block();
+      if (s_free_frames > 0) {
+        s_external_fragmentation = 1.0 - (double) s_largest_free_block_frames / s_free_frames;
+      }
+
+      size_t max_frames = 0;
+      size_t total_frames = 0;
+      for (size_t frames : s_channel_frames) {
+        max_frames = std::max(max_frames, frames);
+        total_frames += frames;
+      }
+      if (total_frames > 0) {
+        s_channel_imbalance = (double) max_frames * s_channel_frames.size() / total_frames;
+      }
+    };
+
+  public:
+    bool translate(Request& req) override {
+      Addr_t vfn = req.addr >> m_offsetbits;
+      Addr_t pfn = -1;
+
+      TLBEntry& tlb_entry = m_tlb[req.source_id * m_tlb_entries + (vfn & (m_tlb_entries - 1))];
+      if (tlb_entry.vfn == vfn) {
+        pfn = tlb_entry.pfn;
+      } else {
+        pfn = walk(req.source_id, vfn, req.addr);
+        tlb_entry = {vfn, pfn};
+      }
+
+      Addr_t p_addr = (pfn << m_offsetbits) | (req.addr & ((Addr_t(1) << m_offsetbits) - 1));
+
+      DEBUG_LOG(DTRANSLATE, m_translation_logger, "Translated Addr {}, VFN {} to Addr {}, PFN {}.", req.addr, vfn, p_addr, pfn);
+
+      req.addr = p_addr;
+      return true;
+    };
+
+    bool reserve(const std::string& type, Addr_t addr) override {
+      Addr_t frame = addr >> m_offsetbits;
+      if (frame < 0 || frame >= (Addr_t) m_num_frames) {
+        return false;
+      }
+      size_t slot = m_frame_slots[frame];
+      if (slot < m_num_usable_frames) {
+        // Frames that are already mapped stay mapped, but will never be picked for swapping
+        swap_frame_slots(slot, m_num_usable_frames - 1);
+        m_num_usable_frames--;
+        m_allocator.carve(frame);
+      }
+      return true;
+    };
+
+    Addr_t get_max_addr() override {
+      return m_max_paddr;
+    };
+
+  private:
+    // Page table entries: 0 = undecided, 1 = split into smaller pages, otherwise base frame + 2
+    static constexpr Addr_t m_entry_split = 1;
+    static constexpr Addr_t m_entry_base = 2;
+
+    Addr_t walk(int core_id, Addr_t vfn, Addr_t addr) {
+      auto& core_translation = m_translation[core_id];
+      size_t smallest = m_page_orders.size() - 1;
+      for (size_t size_id = 0; size_id <= smallest; size_id++) {
+        int order = m_page_orders[size_id];
+        PageTable& table = core_translation[size_id];
+        size_t leaf = table.walk(vfn >> order);
+
+        if (table[leaf] == 0) {
+          // First touch to this virtual region at this page size
+          if (size_id == smallest) {
+            table[leaf] = allocate_frame(addr, vfn) + m_entry_base;
+            s_num_pages[size_id]++;
+          } else if (m_allocator_rng.uniform_real() < m_page_fractions[size_id]) {
+            Addr_t base = -1;
+            if (m_allocator.allocate(order, base)) {
+              table[leaf] = base + m_entry_base;
+              s_num_pages[size_id]++;
+              count_channel_frames(base, order);
+            } else {
+              table[leaf] = m_entry_split;
+              s_num_huge_page_fallbacks++;
+            }
+          } else {
+            table[leaf] = m_entry_split;
+          }
+        }
+
+        if (table[leaf] >= m_entry_base) {
+          return table[leaf] - m_entry_base + (vfn & ((Addr_t(1) << order) - 1));
+        }
+      }
+      // Unreachable: the smallest page size is always mapped above
+      return -1;
+    };
+
+    Addr_t allocate_frame(Addr_t addr, Addr_t vfn) {
+      Addr_t frame = -1;
+      if (m_allocator.allocate(0, frame)) {
+        count_channel_frames(frame, 0);
+        return frame;
+      }
+
+      // We run out of physical frames. Randomly replace a non-reserved frame (swap latency not modeled!)
+      if (m_num_usable_frames == 0) {
+        throw std::runtime_error("All physical frames are reserved!");
+      }
+      frame = m_frames[m_allocator_rng.uniform_int(0, m_num_usable_frames - 1)];
+      m_translation_logger->warn("Swapping out PFN {} for Addr {}, VFN {}.", frame, addr, vfn);
+      s_num_swapped_frames++;
+      return frame;
+    };
+
+    /**
+     * @brief   Counts the frames of the block of 2^order frames at base towards the channels they map to.
+     * @details
+     * The address mappers compute every channel bit as a single address bit or a XOR of address bits, so the
+     * channels of the frames in an aligned block are those of the block at frame 0, XORed with the channel of
+     * its base. Only the first block of each order is mapped frame by frame.
+     */
+    void count_channel_frames(Addr_t base, int order) {
+      if (s_channel_frames.empty()) {
+        s_channel_frames.resize(m_colors.get_num_channels(), 0);
+      }
+      std::vector<size_t>& block_frames = m_block_channel_frames[order];
+      if (block_frames.empty()) {
+        block_frames.resize(m_colors.get_num_channels(), 0);
+        for (Addr_t frame = 0; frame < (Addr_t(1) << order); frame++) {
+          block_frames[m_colors.get_channel(frame)]++;
+        }
+      }
+      int base_channel = m_colors.get_channel(base);
+      for (int channel = 0; channel < (int) block_frames.size(); channel++) {
+        s_channel_frames[channel ^ base_channel] += block_frames[channel];
+      }
+    };
+
+    void swap_frame_slots(size_t slot_a, size_t slot_b) {
+      PFN_t frame_a = m_frames[slot_a];
+      PFN_t frame_b = m_frames[slot_b];
+      m_frames[slot_a] = frame_b;
+      m_frames[slot_b] = frame_a;
+      m_frame_slots[frame_b] = slot_a;
+      m_frame_slots[frame_a] = slot_b;
+    };
+};
+
+
+class BuddyTranslation final : public BuddyTranslationBase, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(ITranslation, BuddyTranslation, "BuddyTranslation", "Allocate 4KB pages contiguously in first-touch order from a buddy allocator.");
+
+  public:
+    void init() override {
+      init_translation(this, {0}, {1.0});
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      setup_translation(this, memory_system);
+    };
+
+    void finalize() override {
+      finalize_translation();
+    };
+};
+
+
+class HugePageTranslation final : public BuddyTranslationBase, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(ITranslation, HugePageTranslation, "HugePageTranslation", "Back virtual memory with a mix of 4KB, 2MB and 1GB pages from a buddy allocator.");
+
+  public:
+    void init() override {
+      double fraction_1G = param<double>("huge_1G_fraction").desc("Probability that a newly touched 1GB virtual region is backed by a 1GB page.").default_val(0.0);
+      double fraction_2M = param<double>("huge_2M_fraction").desc("Probability that a newly touched 2MB virtual region is backed by a 2MB page.").default_val(0.5);
+      if (fraction_1G < 0.0 || fraction_1G > 1.0 || fraction_2M < 0.0 || fraction_2M > 1.0) {
+        throw ConfigurationError("Huge page fractions for HugePageTranslation must be within [0, 1]!");
+      }
+      // 1GB = 2^18 frames, 2MB = 2^9 frames
+      init_translation(this, {18, 9, 0}, {fraction_1G, fraction_2M, 1.0});
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      setup_translation(this, memory_system);
+    };
+
+    void finalize() override {
+      finalize_translation();
+    };
+};
+
+}   // namespace Ramulator
@@ -0,0 +1,314 @@
+#include <vector>
+#include <limits>
+
+#include "base/base.h"
+#include "translation/translation.h"
+#include "frontend/frontend.h"
+#include "memory_system/memory_system.h"
+#include "translation/impl/paging.h"
+
+
+namespace Ramulator {
+
+class ColoringTranslation : public ITranslation, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(ITranslation, ColoringTranslation, "ColoringTranslation", "Steer the pages of each core to a chosen set of channels (or ranks).");
+
+  IFrontEnd* m_frontend;
+
+  protected:
+    struct TLBEntry {
+      Addr_t vpn = -1;
+      Addr_t ppn = -1;
+    };
+
+    using PPN_t = uint32_t;
+
+    RandomStream m_allocator_rng;
+
+    Addr_t m_max_paddr;         // Max physical address
+    Addr_t m_pagesize;          // Page size in bytes
+    int    m_offsetbits;        // The number of bits for the page offset
+    Addr_t m_offset_mask;       // Mask to extract the page offset
+    size_t m_num_pages;         // The total number of physical pages
+
+    bool m_color_by_rank = false;
+    PageColorMap m_colors;
+    int m_num_colors = -1;
+
+    // Free pages of each color. Built on the first translation, when the address mapper is guaranteed to be set up.
+    bool m_is_colored = false;
+    std::vector<std::vector<PPN_t>> m_free_pages;
+    std::vector<int> m_page_channels;                // The channel of each page, filled when the pages are colored
+
+    // All pages, partitioned as [usable | reserved], so that a random swap victim is drawn in O(1)
+    std::vector<PPN_t> m_pages;
+    std::vector<PPN_t> m_page_slots;                 // The position of each page in m_pages
+    size_t m_num_usable_pages = 0;                   // Pages in [0, m_num_usable_pages) are not reserved
+
+    std::vector<std::vector<int>> m_core_colors;     // Colors each core allocates from
+    std::vector<int> m_core_next_color;              // Round-robin pointer into m_core_colors
+
+    std::vector<PageTable> m_translation;   // Per-core page tables
+
+    int m_tlb_entries = -1;
+    std::vector<TLBEntry> m_tlb;            // Per-core TLBs, flattened as [core][entry]
+
+    size_t s_num_color_fallbacks = 0;
+    size_t s_num_swapped_pages = 0;
+    std::vector<size_t> s_color_pages;
+    std::vector<size_t> s_color_free_pages;
+    std::vector<size_t> s_channel_pages;
+    double s_channel_imbalance = 0.0;
+
+
+  public:
+    void init() override {
+      m_max_paddr   = param<Addr_t>("max_addr").desc("Max physical address of the memory system.").required();
+      m_pagesize    = param<Addr_t>("pagesize_KB").desc("Pagesize in KB.").default_val(4) << 10;
+      m_offsetbits  = calc_log2(m_pagesize);
+      m_offset_mask = m_pagesize - 1;
+
+      m_tlb_entries = param<int>("tlb_entries").desc("Number of entries of the per-core direct-mapped translation cache.").default_val(64);
+      if (m_tlb_entries <= 0 || (m_tlb_entries & (m_tlb_entries - 1)) != 0) {
+        throw ConfigurationError("Number of TLB entries ({}) for ColoringTranslation must be a power of two!", m_tlb_entries);
+      }
+
+      std::string color_by = param<std::string>("color_by").desc("Color pages by \"channel\" or by \"rank\" (i.e., channel and rank).").default_val("channel");
+      if (color_by == "channel") {
+        m_color_by_rank = false;
+      } else if (color_by == "rank") {
+        m_color_by_rank = true;
+      } else {
+        throw ConfigurationError("Unknown color_by \"{}\" for ColoringTranslation!", color_by);
+      }
+
+      m_num_pages = m_max_paddr / m_pagesize;
+      if (m_num_pages > std::numeric_limits<PPN_t>::max()) {
+        throw ConfigurationError("Too many physical pages ({}) for ColoringTranslation!", m_num_pages);
+      }
+      m_pages.resize(m_num_pages);
+      m_page_slots.resize(m_num_pages);
+      for (size_t ppn = 0; ppn < m_num_pages; ppn++) {
+        m_pages[ppn] = ppn;
+        m_page_slots[ppn] = ppn;
+      }
+      m_num_usable_pages = m_num_pages;
+
+      m_frontend = cast_parent<IFrontEnd>();
+      int num_cores = m_frontend->get_num_cores();
+      int vpn_bits = std::numeric_limits<Addr_t>::digits - m_offsetbits;
+      m_translation.resize(num_cores, PageTable(vpn_bits));
+      m_tlb.resize(num_cores * m_tlb_entries);
+
+      // Validated against the number of colors when the pages are colored
+      m_core_colors = param<std::vector<std::vector<int>>>("core_colors").desc("The list of colors each core allocates from. Defaults to spreading the colors evenly across cores.").default_val({});
+      if (!m_core_colors.empty() && (int) m_core_colors.size() != num_cores) {
+        throw ConfigurationError("core_colors for ColoringTranslation must have one entry per core ({})!", num_cores);
+      }
+      m_core_next_color.resize(num_cores, 0);
+
+      m_logger = Logging::create_logger("ColoringTranslation");
+
+      register_stat(s_num_color_fallbacks).name("num_color_fallbacks").desc("Pages allocated outside of the colors of the core");
+      register_stat(s_num_swapped_pages).name("num_swapped_pages");
+      register_stat(s_color_pages).name("color_pages");
+      register_stat(s_color_free_pages).name("color_free_pages").computed_at_finalize();
+      register_stat(s_channel_pages).name("channel_pages");
+      register_stat(s_channel_imbalance).name("channel_imbalance").desc("Max over mean of channel_pages").computed_at_finalize();
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_allocator_rng = create_rng_stream();
+      m_colors.setup(memory_system->get_ifce<IAddrMapper>(), m_offsetbits, m_color_by_rank);
+    };
+
+    void finalize() override {
+      for (int color = 0; color < m_num_colors && m_is_colored; color++) {
+        s_color_free_pages[color] = 0;
+        for (PPN_t ppn : m_free_pages[color]) {
+          s_color_free_pages[color] += !is_reserved(ppn);
+        }
+      }
+
+      size_t max_pages = 0;
+      size_t total_pages = 0;
+      for (size_t pages : s_channel_pages) {
+        max_pages = std::max(max_pages, pages);
+        total_pages += pages;
+      }
+      if (total_pages > 0) {
+        s_channel_imbalance = (double) max_pages * s_channel_pages.size() / total_pages;
+      }
+    };
+
+    bool translate(Request& req) override {
+      Addr_t vpn = req.addr >> m_offsetbits;
+      Addr_t ppn = -1;
+
+      TLBEntry& tlb_entry = m_tlb[req.source_id * m_tlb_entries + (vpn & (m_tlb_entries - 1))];
+      if (tlb_entry.vpn == vpn) {
+        ppn = tlb_entry.ppn;
+      } else {
+        auto& core_translation = m_translation[req.source_id];
+        size_t leaf = core_translation.walk(vpn);
+        if (core_translation[leaf] == 0) {
+          core_translation[leaf] = allocate_page(req.source_id, req.addr, vpn) + 1;
+        }
+        ppn = core_translation[leaf] - 1;
+        tlb_entry = {vpn, ppn};
+      }
+
+      Addr_t p_addr = (ppn << m_offsetbits) | (req.addr & m_offset_mask);
+
+      DEBUG_LOG(DTRANSLATE, m_logger, "Translated Addr {}, VPN {} to Addr {}, PPN {}.", req.addr, vpn, p_addr, ppn);
+
+      req.addr = p_addr;
+      return true;
+    };
+
+    bool reserve(const std::string& type, Addr_t addr) override {
+      Addr_t ppn = addr >> m_offsetbits;
+      if (ppn < 0 || ppn >= (Addr_t) m_num_pages) {
+        return false;
+      }
+      size_t slot = m_page_slots[ppn];
+      if (slot < m_num_usable_pages) {
+        // Reserved pages are skipped when they are drawn from the free lists
+        swap_page_slots(slot, m_num_usable_pages - 1);
+        m_num_usable_pages--;
+      }
+      return true;
+    };
+
+    Addr_t get_max_addr() override {
+      return m_max_paddr;
+    };
+
+  private:
+    /**
+     * @brief   Defaults and validates the colors of the cores, once the number of colors is known.
+     */
+    void setup_colors() {
+      m_num_colors = m_colors.get_num_colors();
+
+      int num_cores = m_translation.size();
+      if (m_core_colors.empty()) {
+        m_core_colors.resize(num_cores);
+        if (num_cores >= m_num_colors) {
+          for (int core_id = 0; core_id < num_cores; core_id++) {
+            m_core_colors[core_id].push_back(core_id % m_num_colors);
+          }
+        } else {
+          for (int color = 0; color < m_num_colors; color++) {
+            m_core_colors[color % num_cores].push_back(color);
+          }
+        }
+      }
+      for (int core_id = 0; core_id < num_cores; core_id++) {
+        if (m_core_colors[core_id].empty()) {
+          throw ConfigurationError("Core {} has no colors in ColoringTranslation!", core_id);
+        }
+        for (int color : m_core_colors[core_id]) {
+          if (color < 0 || color >= m_num_colors) {
+            throw ConfigurationError("Color {} of core {} is out of range [0, {}) in ColoringTranslation!", color, core_id, m_num_colors);
+          }
+        }
+      }
+
+      s_color_pages.resize(m_num_colors, 0);
+      s_color_free_pages.resize(m_num_colors, 0);
+      s_channel_pages.resize(m_colors.get_num_channels(), 0);
+    };
+
+    void color_pages() {
+      setup_colors();
+      m_free_pages.resize(m_num_colors);
+      m_page_channels.resize(m_num_pages);
+      for (size_t ppn = 0; ppn < m_num_pages; ppn++) {
+        int channel = -1;
+        int color = m_colors.get_color(ppn, channel);
+        m_page_channels[ppn] = channel;
+        if (!is_reserved(ppn)) {
+          m_free_pages[color].push_back(ppn);
+        }
+      }
+      for (int color = 0; color < m_num_colors; color++) {
+        if (m_free_pages[color].empty()) {
+          m_logger->warn("No page maps to color {}. Is the page size smaller than the channel/rank interleaving granularity?", color);
+        }
+      }
+      m_is_colored = true;
+    };
+
+    /**
+     * @brief   Draws a random non-reserved free page of the color. Returns false if there is none.
+     */
+    bool draw_page(int color, Addr_t& ppn) {
+      auto& free_pages = m_free_pages[color];
+      while (!free_pages.empty()) {
+        size_t slot = m_allocator_rng.uniform_int(0, free_pages.size() - 1);
+        ppn = free_pages[slot];
+        free_pages[slot] = free_pages.back();
+        free_pages.pop_back();
+        if (!is_reserved(ppn)) {
+          return true;
+        }
+      }
+      return false;
+    };
+
+    Addr_t allocate_page(int core_id, Addr_t addr, Addr_t vpn) {
+      if (!m_is_colored) {
+        color_pages();
+      }
+
+      Addr_t ppn = -1;
+      int color = -1;
+
+      // Try the colors of the core first, round-robin
+      const auto& core_colors = m_core_colors[core_id];
+      for (size_t i = 0; i < core_colors.size() && color < 0; i++) {
+        int candidate = core_colors[m_core_next_color[core_id]];
+        m_core_next_color[core_id] = (m_core_next_color[core_id] + 1) % core_colors.size();
+        if (draw_page(candidate, ppn)) {
+          color = candidate;
+        }
+      }
+
+      // Then any color
+      for (int candidate = 0; candidate < m_num_colors && color < 0; candidate++) {
+        if (draw_page(candidate, ppn)) {
+          color = candidate;
+          s_num_color_fallbacks++;
+        }
+      }
+
+      if (color < 0) {
+        // We run out of physical pages. Randomly replace a non-reserved page (swap latency not modeled!)
+        if (m_num_usable_pages == 0) {
+          throw std::runtime_error("ColoringTranslation: All physical pages are reserved!");
+        }
+        ppn = m_pages[m_allocator_rng.uniform_int(0, m_num_usable_pages - 1)];
+        m_logger->warn("Swapping out PPN {} for Addr {}, VPN {}.", ppn, addr, vpn);
+        s_num_swapped_pages++;
+        return ppn;
+      }
+
+      s_color_pages[color]++;
+      s_channel_pages[m_page_channels[ppn]]++;
+      return ppn;
+    };
+
+    bool is_reserved(Addr_t ppn) const { return m_page_slots[ppn] >= m_num_usable_pages; };
+
+    void swap_page_slots(size_t slot_a, size_t slot_b) {
+      PPN_t ppn_a = m_pages[slot_a];
+      PPN_t ppn_b = m_pages[slot_b];
+      m_pages[slot_a] = ppn_b;
+      m_pages[slot_b] = ppn_a;
+      m_page_slots[ppn_b] = slot_a;
+      m_page_slots[ppn_a] = slot_b;
+    };
+};
+
+}   // namespace Ramulator
@@ -0,0 +1,191 @@
+#ifndef     RAMULATOR_TRANSLATION_PAGING_H
+#define     RAMULATOR_TRANSLATION_PAGING_H
+
+#include <vector>
+#include <set>
+#include <string>
+
+#include "base/base.h"
+#include "base/request.h"
+#include "addr_mapper/addr_mapper.h"
+
+
+namespace Ramulator {
+
+/**
+ * @brief   A radix page table.
+ * @details
+ * All nodes live in one flat pool of fixed-size blocks. An interior entry holds the block index of the
+ * next-level node. Leaf entries are opaque to the table, except that zero means "not present".
+ */
+class PageTable {
+  public:
+    static constexpr int m_bits_per_level = 9;
+    static constexpr int m_entries_per_node = 1 << m_bits_per_level;
+
+  private:
+    int m_num_levels = 0;
+    std::vector<Addr_t> m_nodes;
+
+  public:
+    PageTable(int vpn_bits) {
+      m_num_levels = std::max((vpn_bits + m_bits_per_level - 1) / m_bits_per_level, 1);
+      // Allocate the root node
+      m_nodes.resize(m_entries_per_node, 0);
+    };
+
+    /**
+     * @brief   Walks the table and returns the index of the leaf entry for vpn. Missing interior nodes are allocated.
+     */
+    size_t walk(Addr_t vpn) {
+      size_t node_base = 0;
+      for (int level = m_num_levels - 1; level > 0; level--) {
+        size_t entry = node_base + ((uint64_t(vpn) >> (level * m_bits_per_level)) & (m_entries_per_node - 1));
+        if (m_nodes[entry] == 0) {
+          Addr_t new_node = m_nodes.size() / m_entries_per_node;
+          m_nodes.resize(m_nodes.size() + m_entries_per_node, 0);
+          m_nodes[entry] = new_node;
+        }
+        node_base = m_nodes[entry] * m_entries_per_node;
+      }
+      return node_base + (uint64_t(vpn) & (m_entries_per_node - 1));
+    };
+
+    Addr_t& operator[](size_t leaf_entry) { return m_nodes[leaf_entry]; };
+};
+
+
+/**
+ * @brief   A binary buddy allocator over physical frames.
+ * @details
+ * Frames are never returned, so there is no coalescing. Allocation always returns the lowest free block of the
+ * requested order, so consecutive allocations are physically contiguous for as long as memory is unfragmented.
+ */
+class BuddyAllocator {
+  private:
+    int m_max_order = -1;
+    std::vector<std::set<Addr_t>> m_free_blocks;   // Base frame of every free block, per order
+    size_t m_num_free_frames = 0;
+
+  public:
+    BuddyAllocator() = default;
+    BuddyAllocator(size_t num_frames, int max_order) : m_max_order(max_order) {
+      m_free_blocks.resize(max_order + 1);
+      // Cover [0, num_frames) with the largest naturally-aligned blocks
+      Addr_t base = 0;
+      for (int order = max_order; order >= 0; order--) {
+        Addr_t block_size = Addr_t(1) << order;
+        while (base + block_size <= (Addr_t) num_frames) {
+          m_free_blocks[order].insert(base);
+          base += block_size;
+        }
+      }
+      m_num_free_frames = num_frames;
+    };
+
+    /**
+     * @brief   Allocates a block of 2^order frames and returns its base frame in base. Returns false if no free block is large enough.
+     */
+    bool allocate(int order, Addr_t& base) {
+      int from_order = order;
+      while (from_order <= m_max_order && m_free_blocks[from_order].empty()) {
+        from_order++;
+      }
+      if (from_order > m_max_order) {
+        return false;
+      }
+
+      base = *m_free_blocks[from_order].begin();
+      m_free_blocks[from_order].erase(m_free_blocks[from_order].begin());
+      // Split down, keeping the lower half and freeing the upper half at each order
+      while (from_order > order) {
+        from_order--;
+        m_free_blocks[from_order].insert(base + (Addr_t(1) << from_order));
+      }
+      m_num_free_frames -= size_t(1) << order;
+      return true;
+    };
+
+    /**
+     * @brief   Removes a single frame from the free blocks. Returns false if the frame is not free.
+     */
+    bool carve(Addr_t frame) {
+      for (int order = 0; order <= m_max_order; order++) {
+        Addr_t base = frame & ~((Addr_t(1) << order) - 1);
+        auto it = m_free_blocks[order].find(base);
+        if (it == m_free_blocks[order].end()) {
+          continue;
+        }
+        m_free_blocks[order].erase(it);
+        // Split down, freeing the half that does not contain the frame at each order
+        while (order > 0) {
+          order--;
+          Addr_t half = Addr_t(1) << order;
+          if (frame < base + half) {
+            m_free_blocks[order].insert(base + half);
+          } else {
+            m_free_blocks[order].insert(base);
+            base += half;
+          }
+        }
+        m_num_free_frames--;
+        return true;
+      }
+      return false;
+    };
+
+    size_t get_num_free_frames() const { return m_num_free_frames; };
+
+    size_t get_largest_free_block() const {
+      for (int order = m_max_order; order >= 0; order--) {
+        if (!m_free_blocks[order].empty()) {
+          return size_t(1) << order;
+        }
+      }
+      return 0;
+    };
+};
+
+
+/**
+ * @brief   Classifies physical frames by the channel (and optionally rank) their base address maps to.
+ * @details
+ * Must only be queried once the memory system is set up (i.e., not in the setup of the translation), as the
+ * address mapper learns the organization of the DRAM in its own setup.
+ */
+class PageColorMap {
+  private:
+    IAddrMapper* m_addr_mapper = nullptr;
+    int m_offsetbits = -1;
+    bool m_color_by_rank = false;
+
+  public:
+    void setup(IAddrMapper* addr_mapper, int offsetbits, bool color_by_rank) {
+      m_addr_mapper = addr_mapper;
+      m_offsetbits = offsetbits;
+      m_color_by_rank = color_by_rank;
+    };
+
+    int get_num_channels() const { return m_addr_mapper->get_num_channels(); };
+    int get_num_colors() const { return m_addr_mapper->get_num_channels() * (m_color_by_rank ? m_addr_mapper->get_num_ranks() : 1); };
+
+    /**
+     * @brief   Returns the color of the frame and its channel in channel.
+     */
+    int get_color(Addr_t frame, int& channel) {
+      if (!m_color_by_rank) {
+        channel = m_addr_mapper->get_channel(frame << m_offsetbits);
+        return channel;
+      }
+      int rank = -1;
+      channel = m_addr_mapper->get_channel(frame << m_offsetbits, &rank);
+      return channel * m_addr_mapper->get_num_ranks() + rank;
+    };
+
+    int get_channel(Addr_t frame) { return m_addr_mapper->get_channel(frame << m_offsetbits); };
+};
+
+}        // namespace Ramulator
+
+
+#endif   // RAMULATOR_TRANSLATION_PAGING_H
@@ -1,11 +1,11 @@
 #include <iostream>
-#include <unordered_set>
 #include <vector>
-#include <random>
+#include <limits>
 
 #include "base/base.h"
 #include "translation/translation.h"
 #include "frontend/frontend.h"
+#include "translation/impl/paging.h"
 
 
 namespace Ramulator {
@@ -16,93 +16,176 @@ class RandomTranslation : public ITranslation, public Implementation {
   IFrontEnd* m_frontend;
 
   protected:
-    std::mt19937_64 m_allocator_rng;
+    /**
+     * @brief   A small direct-mapped cache of recent translations in front of the page table.
+     */
+    struct TLBEntry {
+      Addr_t vpn = -1;
+      Addr_t ppn = -1;
+    };
+
+    using PPN_t = uint32_t;
+
+    int m_seed = 0;
+    RandomStream m_allocator_rng;
 
     Addr_t m_max_paddr;         // Max physical address
     Addr_t m_pagesize;          // Page size in bytes
     int    m_offsetbits;        // The number of bits for the page offset
-    size_t m_num_pages;         // The total number of physical pages 
+    Addr_t m_offset_mask;       // Mask to extract the page offset
+    size_t m_num_pages;         // The total number of physical pages
+
+    // All physical pages, partitioned as [free | allocated | reserved]. A random free page is drawn by
+    // swapping it to the boundary, so allocation, reservation and swap-victim selection are all O(1).
+    std::vector<PPN_t> m_pages;
+    std::vector<PPN_t> m_page_slots;     // The position of each PPN in m_pages
+    size_t m_num_free_physical_pages;    // Pages in [0, m_num_free_physical_pages) are free
+    size_t m_num_usable_physical_pages;  // Pages in [m_num_usable_physical_pages, m_num_pages) are reserved
 
-    std::vector<bool> m_free_physical_pages;   // The set of remaining pages.
-    size_t m_num_free_physical_pages;
+    std::vector<PageTable> m_translation;   // Per-core page tables
 
-    using Translation_t = std::vector<std::unordered_map<Addr_t, Addr_t>>;
-    Translation_t m_translation;    // A vector of <vpn:ppn> maps, each core has its own map
+    int m_tlb_entries = -1;
+    std::vector<TLBEntry> m_tlb;            // Per-core TLBs, flattened as [core][entry]
 
-    std::unordered_set<Addr_t> m_reserved_pages;   // A vector of reserved pages
+    size_t s_tlb_hits = 0;
+    size_t s_tlb_misses = 0;
+    size_t s_num_allocated_pages = 0;
+    size_t s_num_swapped_pages = 0;
 
 
   public:
     void init() override {
-      int seed = param<int>("seed").desc("The seed for the random number generator used to allocate pages.").default_val(123);
-      m_allocator_rng.seed(seed);
+      m_seed = param<int>("seed").desc("Offset of the RNG stream used to allocate pages, on top of the top-level seed.").default_val(0);
 
       m_max_paddr   = param<Addr_t>("max_addr").desc("Max physical address of the memory system.").required();
       m_pagesize    = param<Addr_t>("pagesize_KB").desc("Pagesize in KB.").default_val(4) << 10;
       m_offsetbits  = calc_log2(m_pagesize);
+      m_offset_mask = m_pagesize - 1;
+
+      m_tlb_entries = param<int>("tlb_entries").desc("Number of entries of the per-core direct-mapped translation cache.").default_val(64);
+      if (m_tlb_entries <= 0 || (m_tlb_entries & (m_tlb_entries - 1)) != 0) {
+        throw ConfigurationError("Number of TLB entries ({}) for RandomTranslation must be a power of two!", m_tlb_entries);
+      }
 
       // Initially, all physical pages are free
       m_num_pages = m_max_paddr / m_pagesize;
-      m_free_physical_pages.resize(m_num_pages, true);
+      if (m_num_pages > std::numeric_limits<PPN_t>::max()) {
+        throw ConfigurationError("Too many physical pages ({}) for RandomTranslation!", m_num_pages);
+      }
+      m_pages.resize(m_num_pages);
+      m_page_slots.resize(m_num_pages);
+      for (size_t ppn = 0; ppn < m_num_pages; ppn++) {
+        m_pages[ppn] = ppn;
+        m_page_slots[ppn] = ppn;
+      }
       m_num_free_physical_pages = m_num_pages;
+      m_num_usable_physical_pages = m_num_pages;
 
       m_frontend = cast_parent<IFrontEnd>();
-      m_translation.resize(m_frontend->get_num_cores());
+      int num_cores = m_frontend->get_num_cores();
+      int vpn_bits = std::numeric_limits<Addr_t>::digits - m_offsetbits;
+      m_translation.resize(num_cores, PageTable(vpn_bits));
+      m_tlb.resize(num_cores * m_tlb_entries);
 
       m_logger = Logging::create_logger("RandomTranslation");
+
+      register_stat(s_tlb_hits).name("tlb_hits");
+      register_stat(s_tlb_misses).name("tlb_misses");
+      register_stat(s_num_allocated_pages).name("num_allocated_pages");
+      register_stat(s_num_swapped_pages).name("num_swapped_pages");
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_allocator_rng = create_rng_stream("", m_seed);
     };
 
     bool translate(Request& req) override {
       Addr_t vpn = req.addr >> m_offsetbits;
-
-      auto& core_translation = m_translation[req.source_id];
-      auto target = core_translation.find(vpn);
-      if (target == core_translation.end()) {
-        // No previous translation record. Assign a new page
-        if (m_num_free_physical_pages == 0) {
-          // We run out of physical pages. Randomly replace a previously assigned page (swap latency not modeled!)
-          Addr_t ppn_to_replace = m_allocator_rng() % m_num_pages;
-          // We do not replace a reserved page
-          while (m_reserved_pages.find(ppn_to_replace) != m_reserved_pages.end()) {
-            ppn_to_replace = m_allocator_rng() % m_num_pages;
-          }
-          core_translation[vpn] = ppn_to_replace;
-          m_logger->warn("Swapping out PPN {} for Addr {}, VPN {}.", ppn_to_replace, req.addr, vpn);
-        } else {
-          // We have available physical pages. Randomly assign one.
-          Addr_t ppn_to_assign = m_allocator_rng() % m_num_pages;
-          // We do not assign a reserved page or an already assigned page
-          while (
-            (m_reserved_pages.find(ppn_to_assign) != m_reserved_pages.end())
-            || (!m_free_physical_pages[ppn_to_assign])
-          ) {
-            ppn_to_assign = m_allocator_rng() % m_num_pages;
-          }
-          core_translation[vpn] = ppn_to_assign;
-          m_num_free_physical_pages--;
+      Addr_t ppn = -1;
+
+      TLBEntry& tlb_entry = m_tlb[req.source_id * m_tlb_entries + (vpn & (m_tlb_entries - 1))];
+      if (tlb_entry.vpn == vpn) {
+        s_tlb_hits++;
+        ppn = tlb_entry.ppn;
+      } else {
+        s_tlb_misses++;
+        auto& core_translation = m_translation[req.source_id];
+        size_t leaf = core_translation.walk(vpn);
+        if (core_translation[leaf] == 0) {
+          // No previous translation record. Assign a new page
+          core_translation[leaf] = allocate_page(req.addr, vpn) + 1;
         }
-      } 
+        // Mappings are never invalidated, so the TLB never has to be shot down
+        ppn = core_translation[leaf] - 1;
+        tlb_entry = {vpn, ppn};
+      }
 
       // We either found an existing translation or have assigned a new page
-      Addr_t p_addr = (core_translation[vpn] << m_offsetbits) | (req.addr & ((1 << m_offsetbits) - 1));
+      Addr_t p_addr = (ppn << m_offsetbits) | (req.addr & m_offset_mask);
 
-      DEBUG_LOG(DTRANSLATE, m_logger, "Translated Addr {}, VPN {} to Addr {}, PPN {}.", req.addr, vpn, p_addr, core_translation[vpn]);
+      DEBUG_LOG(DTRANSLATE, m_logger, "Translated Addr {}, VPN {} to Addr {}, PPN {}.", req.addr, vpn, p_addr, ppn);
 
       req.addr = p_addr;
       return true;
-    };    
+    };
 
     bool reserve(const std::string& type, Addr_t addr) override {
       Addr_t ppn = addr >> m_offsetbits;
-      // Add page to reserved pages if it is not already reserved
-      m_reserved_pages.insert(ppn);
-      // std::cout << "Reserved PPN " << ppn << "." << std::endl;
+      if (ppn < 0 || ppn >= (Addr_t) m_num_pages) {
+        return false;
+      }
+      size_t slot = m_page_slots[ppn];
+      if (slot >= m_num_usable_physical_pages) {
+        // Already reserved
+        return true;
+      }
+      if (slot < m_num_free_physical_pages) {
+        // Move the page out of the free partition first
+        swap_slots(slot, m_num_free_physical_pages - 1);
+        slot = m_num_free_physical_pages - 1;
+        m_num_free_physical_pages--;
+      }
+      // Then move it out of the allocated partition
+      swap_slots(slot, m_num_usable_physical_pages - 1);
+      m_num_usable_physical_pages--;
       return true;
     };
 
     Addr_t get_max_addr() override {
       return m_max_paddr;
     };
+
+  private:
+    Addr_t allocate_page(Addr_t addr, Addr_t vpn) {
+      if (m_num_free_physical_pages == 0) {
+        // We run out of physical pages. Randomly replace a previously assigned page (swap latency not modeled!)
+        // We do not replace a reserved page
+        if (m_num_usable_physical_pages == 0) {
+          throw std::runtime_error("RandomTranslation: All physical pages are reserved!");
+        }
+        Addr_t ppn_to_replace = m_pages[m_allocator_rng.uniform_int(0, m_num_usable_physical_pages - 1)];
+        m_logger->warn("Swapping out PPN {} for Addr {}, VPN {}.", ppn_to_replace, addr, vpn);
+        s_num_swapped_pages++;
+        return ppn_to_replace;
+      }
+
+      // We have available physical pages. Randomly assign one and move it into the allocated partition.
+      size_t slot = m_allocator_rng.uniform_int(0, m_num_free_physical_pages - 1);
+      Addr_t ppn_to_assign = m_pages[slot];
+      swap_slots(slot, m_num_free_physical_pages - 1);
+      m_num_free_physical_pages--;
+      s_num_allocated_pages++;
+      return ppn_to_assign;
+    };
+
+    void swap_slots(size_t slot_a, size_t slot_b) {
+      PPN_t ppn_a = m_pages[slot_a];
+      PPN_t ppn_b = m_pages[slot_b];
+      m_pages[slot_a] = ppn_b;
+      m_pages[slot_b] = ppn_a;
+      m_page_slots[ppn_b] = slot_a;
+      m_page_slots[ppn_a] = slot_b;
+    };
 };
 
-}   // namespace Ramulator
\ No newline at end of file
+}   // namespace Ramulator